@@ -0,0 +1,121 @@
+#include "gdwg/breadth_first.hpp"
+#include "gdwg/graph.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <queue>
+#include <random>
+#include <thread>
+#include <vector>
+
+// Searches from a hub of an R-MAT graph, the power-law generator used by Graph500: a few nodes
+// reach most of the graph within a handful of levels, which is where bottom-up pays off.
+namespace {
+	constexpr auto scale = 17;
+	constexpr auto num_nodes = 1 << scale;
+	constexpr auto edge_factor = 16;
+	constexpr auto unreached = std::numeric_limits<std::uint32_t>::max();
+
+	using rmat_graph = gdwg::graph<int, int, gdwg::layout::adjacency>;
+
+	auto build_rmat() -> rmat_graph {
+		auto g = rmat_graph{};
+		for (auto n = 0; n < num_nodes; ++n) {
+			g.insert_node(n);
+		}
+		auto rng = std::mt19937(1);
+		auto quadrant = std::uniform_real_distribution<double>(0, 1);
+		for (auto i = 0; i < num_nodes * edge_factor; ++i) {
+			auto src = 0;
+			auto dst = 0;
+			for (auto bit = 0; bit < scale; ++bit) {
+				auto const q = quadrant(rng);
+				src |= (q >= 0.76 ? 1 : 0) << bit;
+				dst |= ((q >= 0.57 and q < 0.76) or q >= 0.95 ? 1 : 0) << bit;
+			}
+			g.insert_edge(src, dst, 0);
+		}
+		return g;
+	}
+
+	auto rmat() -> rmat_graph const& {
+		static auto const g = build_rmat();
+		return g;
+	}
+
+	auto frozen_rmat() -> gdwg::frozen_graph<int, int> const& {
+		static auto const g = rmat().freeze();
+		return g;
+	}
+
+	// Through the graph itself, one connections() per node.
+	void bm_bfs_connections(benchmark::State& state) {
+		auto const& g = rmat();
+		for (auto _ : state) {
+			auto depth = std::vector<std::uint32_t>(g.id_bound(), unreached);
+			auto queue = std::queue<rmat_graph::node_id>{};
+			auto const source = *g.id_of(0);
+			depth[static_cast<std::size_t>(source)] = 0;
+			queue.push(source);
+			while (not queue.empty()) {
+				auto const u = queue.front();
+				queue.pop();
+				for (auto const v : g.connections(u)) {
+					if (depth[static_cast<std::size_t>(v)] == unreached) {
+						depth[static_cast<std::size_t>(v)] = depth[static_cast<std::size_t>(u)] + 1;
+						queue.push(v);
+					}
+				}
+			}
+			benchmark::DoNotOptimize(depth);
+		}
+	}
+	BENCHMARK(bm_bfs_connections)->Unit(benchmark::kMillisecond);
+
+	// Top-down only, on one thread, over the snapshot.
+	void bm_bfs_frozen_top_down(benchmark::State& state) {
+		auto const& g = frozen_rmat();
+		for (auto _ : state) {
+			auto depth = std::vector<std::uint32_t>(g.num_nodes(), unreached);
+			auto queue = std::vector<std::size_t>{0};
+			depth[0] = 0;
+			for (auto i = std::size_t{0}; i < queue.size(); ++i) {
+				auto const u = queue[i];
+				for (auto const v : g.targets(u)) {
+					if (depth[v] == unreached) {
+						depth[v] = depth[u] + 1;
+						queue.push_back(v);
+					}
+				}
+			}
+			benchmark::DoNotOptimize(depth);
+		}
+	}
+	BENCHMARK(bm_bfs_frozen_top_down)->Unit(benchmark::kMillisecond);
+
+	void bm_breadth_first(benchmark::State& state) {
+		auto const& g = frozen_rmat();
+		auto const bfs = gdwg::breadth_first(g, static_cast<unsigned>(state.range(0)));
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(bfs.depths(0));
+		}
+	}
+	BENCHMARK(bm_breadth_first)
+	   ->Arg(1)
+	   ->Arg(static_cast<std::int64_t>(std::max(1U, std::thread::hardware_concurrency())))
+	   ->Unit(benchmark::kMillisecond)
+	   ->UseRealTime();
+
+	// The reverse rows, built once per breadth_first.
+	void bm_breadth_first_setup(benchmark::State& state) {
+		auto const& g = frozen_rmat();
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(gdwg::breadth_first(g, 1));
+		}
+	}
+	BENCHMARK(bm_breadth_first_setup)->Unit(benchmark::kMillisecond);
+} // namespace
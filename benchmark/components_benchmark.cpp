@@ -0,0 +1,123 @@
+#include "gdwg/components.hpp"
+#include "gdwg/graph.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <thread>
+#include <vector>
+
+// Components of an R-MAT graph, the power-law generator used by Graph500, with 2^17 nodes and
+// 16 edges per node: one giant component and many small ones.
+namespace {
+	constexpr auto scale = 17;
+	constexpr auto num_nodes = 1 << scale;
+	constexpr auto edge_factor = 16;
+
+	using rmat_graph = gdwg::graph<int, int, gdwg::layout::adjacency>;
+
+	auto build_rmat() -> rmat_graph {
+		auto g = rmat_graph{};
+		for (auto n = 0; n < num_nodes; ++n) {
+			g.insert_node(n);
+		}
+		auto rng = std::mt19937(1);
+		auto quadrant = std::uniform_real_distribution<double>(0, 1);
+		for (auto i = 0; i < num_nodes * edge_factor; ++i) {
+			auto src = 0;
+			auto dst = 0;
+			for (auto bit = 0; bit < scale; ++bit) {
+				auto const q = quadrant(rng);
+				src |= (q >= 0.76 ? 1 : 0) << bit;
+				dst |= ((q >= 0.57 and q < 0.76) or q >= 0.95 ? 1 : 0) << bit;
+			}
+			g.insert_edge(src, dst, 0);
+		}
+		return g;
+	}
+
+	auto rmat() -> rmat_graph const& {
+		static auto const g = build_rmat();
+		return g;
+	}
+
+	auto frozen_rmat() -> gdwg::frozen_graph<int, int> const& {
+		static auto const g = rmat().freeze();
+		return g;
+	}
+
+	// Through the graph itself: a search from every unvisited node over connections() and
+	// incoming().
+	void bm_components_search(benchmark::State& state) {
+		auto const& g = rmat();
+		constexpr auto none = std::numeric_limits<std::uint32_t>::max();
+		for (auto _ : state) {
+			auto component = std::vector<std::uint32_t>(g.id_bound(), none);
+			auto stack = std::vector<rmat_graph::node_id>{};
+			for (auto root = std::uint32_t{0}; root < g.id_bound(); ++root) {
+				if (component[root] != none) {
+					continue;
+				}
+				component[root] = root;
+				stack.push_back(static_cast<rmat_graph::node_id>(root));
+				while (not stack.empty()) {
+					auto const u = stack.back();
+					stack.pop_back();
+					auto const visit = [&](rmat_graph::node_id v) {
+						if (component[static_cast<std::size_t>(v)] == none) {
+							component[static_cast<std::size_t>(v)] = root;
+							stack.push_back(v);
+						}
+					};
+					std::ranges::for_each(g.connections(u), visit);
+					std::ranges::for_each(g.incoming(u), visit);
+				}
+			}
+			benchmark::DoNotOptimize(component);
+		}
+	}
+	BENCHMARK(bm_components_search)->Unit(benchmark::kMillisecond);
+
+	void bm_weakly_connected_components(benchmark::State& state) {
+		auto const& g = frozen_rmat();
+		auto const threads = static_cast<unsigned>(state.range(0));
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(gdwg::weakly_connected_components(g, threads));
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(g.num_edges()));
+	}
+	BENCHMARK(bm_weakly_connected_components)
+	   ->Arg(1)
+	   ->Arg(static_cast<std::int64_t>(std::max(1U, std::thread::hardware_concurrency())))
+	   ->Unit(benchmark::kMillisecond)
+	   ->UseRealTime();
+
+	void bm_strongly_connected_components(benchmark::State& state) {
+		auto const& g = rmat();
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(gdwg::strongly_connected_components(g));
+		}
+		state.SetItemsProcessed(state.iterations() * std::int64_t{num_nodes} * edge_factor);
+	}
+	BENCHMARK(bm_strongly_connected_components)->Unit(benchmark::kMillisecond);
+
+	// A path through every node and back to the first: one component, found at a search depth
+	// of 2^17.
+	void bm_strongly_connected_components_cycle(benchmark::State& state) {
+		auto g = rmat_graph{};
+		auto edges = std::vector<rmat_graph::value_type>{};
+		for (auto n = 0; n < num_nodes; ++n) {
+			g.insert_node(n);
+			edges.push_back({n, (n + 1) % num_nodes, 0});
+		}
+		g.insert_edges(edges.begin(), edges.end());
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(gdwg::strongly_connected_components(g));
+		}
+	}
+	BENCHMARK(bm_strongly_connected_components_cycle)->Unit(benchmark::kMillisecond);
+} // namespace
@@ -0,0 +1,233 @@
+#include "gdwg/graph.hpp"
+#include "gdwg/unordered_graph.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace {
+	constexpr auto num_nodes = 1 << 14;
+	constexpr auto out_degree = 64; // num_nodes * out_degree == 2^20 edges
+
+	// Built once and shared by every benchmark in this file.
+	auto large_graph() -> gdwg::graph<int, int> const& {
+		static auto const g = [] {
+			auto g = gdwg::graph<int, int>{};
+			for (auto n = 0; n < num_nodes; ++n) {
+				g.insert_node(n);
+			}
+			for (auto n = 0; n < num_nodes; ++n) {
+				for (auto d = 0; d < out_degree; ++d) {
+					g.insert_edge(n, (n * 31 + d * 257) % num_nodes, d);
+				}
+			}
+			return g;
+		}();
+		return g;
+	}
+
+	void bm_connections(benchmark::State& state) {
+		auto const& g = large_graph();
+		auto src = 0;
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(g.connections(src));
+			src = (src + 7919) % num_nodes;
+		}
+	}
+	BENCHMARK(bm_connections);
+
+	void bm_connections_by_id(benchmark::State& state) {
+		auto const& g = large_graph();
+		auto src = 0;
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(g.connections(*g.id_of(src)));
+			src = (src + 7919) % num_nodes;
+		}
+	}
+	BENCHMARK(bm_connections_by_id);
+
+	// Callers that only test a predicate: the view stops at the first match without copying.
+	void bm_connections_any_of(benchmark::State& state) {
+		auto const& g = large_graph();
+		auto src = 0;
+		for (auto _ : state) {
+			auto const c = g.connections(src);
+			benchmark::DoNotOptimize(std::any_of(c.begin(), c.end(), [](int n) { return n % 2 == 0; }));
+			src = (src + 7919) % num_nodes;
+		}
+	}
+	BENCHMARK(bm_connections_any_of);
+
+	void bm_connections_view_any_of(benchmark::State& state) {
+		auto const& g = large_graph();
+		auto src = 0;
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(
+			   std::ranges::any_of(g.connections_view(src), [](int n) { return n % 2 == 0; }));
+			src = (src + 7919) % num_nodes;
+		}
+	}
+	BENCHMARK(bm_connections_view_any_of);
+
+	void bm_weights(benchmark::State& state) {
+		auto const& g = large_graph();
+		auto src = 0;
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(g.weights(src, (src * 31) % num_nodes));
+			src = (src + 7919) % num_nodes;
+		}
+	}
+	BENCHMARK(bm_weights);
+
+	void bm_is_connected(benchmark::State& state) {
+		auto const& g = large_graph();
+		auto src = 0;
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(g.is_connected(src, (src * 31 + 257) % num_nodes));
+			src = (src + 7919) % num_nodes;
+		}
+	}
+	BENCHMARK(bm_is_connected);
+
+	void bm_incoming(benchmark::State& state) {
+		auto const& g = large_graph();
+		auto dst = 0;
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(g.incoming(dst));
+			dst = (dst + 7919) % num_nodes;
+		}
+	}
+	BENCHMARK(bm_incoming);
+
+	auto large_frozen_graph() -> gdwg::frozen_graph<int, int> const& {
+		static auto const f = large_graph().freeze();
+		return f;
+	}
+
+	void bm_freeze(benchmark::State& state) {
+		auto const& g = large_graph();
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(g.freeze());
+		}
+	}
+	BENCHMARK(bm_freeze)->Unit(benchmark::kMillisecond);
+
+	void bm_frozen_connections(benchmark::State& state) {
+		auto const& f = large_frozen_graph();
+		auto src = 0;
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(f.connections(src));
+			src = (src + 7919) % num_nodes;
+		}
+	}
+	BENCHMARK(bm_frozen_connections);
+
+	void bm_frozen_is_connected(benchmark::State& state) {
+		auto const& f = large_frozen_graph();
+		auto src = 0;
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(f.is_connected(src, (src * 31 + 257) % num_nodes));
+			src = (src + 7919) % num_nodes;
+		}
+	}
+	BENCHMARK(bm_frozen_is_connected);
+
+	// Sums every edge weight: a full sweep over the edge set, through each layout.
+	void bm_sweep_graph(benchmark::State& state) {
+		auto const& g = large_graph();
+		for (auto _ : state) {
+			auto total = 0L;
+			for (auto const& e : g) {
+				total += e.weight;
+			}
+			benchmark::DoNotOptimize(total);
+		}
+	}
+	BENCHMARK(bm_sweep_graph)->Unit(benchmark::kMillisecond);
+
+	void bm_sweep_frozen(benchmark::State& state) {
+		auto const& f = large_frozen_graph();
+		for (auto _ : state) {
+			auto total = 0L;
+			for (auto i = std::size_t{0}; i < f.num_nodes(); ++i) {
+				for (auto const w : f.edge_weights(i)) {
+					total += w;
+				}
+			}
+			benchmark::DoNotOptimize(total);
+		}
+	}
+	BENCHMARK(bm_sweep_frozen)->Unit(benchmark::kMillisecond);
+
+	// What connections() used to cost: a scan over every edge in the graph.
+	void bm_connections_linear_scan(benchmark::State& state) {
+		auto const& g = large_graph();
+		auto src = 0;
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(std::count_if(g.begin(), g.end(), [src](auto const& e) {
+				return e.from == src;
+			}));
+			src = (src + 7919) % num_nodes;
+		}
+	}
+	BENCHMARK(bm_connections_linear_scan)->Iterations(8);
+
+	// Two versions of the graph that differ in one edge. Their fingerprints differ, so operator==
+	// doesn't have to walk either of them.
+	void bm_compare_changed(benchmark::State& state) {
+		auto const& g = large_graph();
+		auto changed = g;
+		changed.insert_edge(0, 0, -1);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(g == changed);
+		}
+	}
+	BENCHMARK(bm_compare_changed);
+
+	// Node lookups by a key that is costly to compare: the tree compares strings sharing a long
+	// prefix at every level, the hash table hashes once and compares once.
+	auto node_names() -> std::vector<std::string> const& {
+		static auto const names = [] {
+			auto v = std::vector<std::string>{};
+			for (auto n = 0; n < num_nodes; ++n) {
+				v.push_back("https://example.com/graph/node/" + std::to_string(n));
+			}
+			return v;
+		}();
+		return names;
+	}
+
+	template<typename Graph>
+	void bm_is_node_by_name(benchmark::State& state) {
+		auto const& names = node_names();
+		auto const g = Graph(names.begin(), names.end());
+		auto n = std::size_t{0};
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(g.is_node(names[n]));
+			n = (n + 7919) % names.size();
+		}
+	}
+	BENCHMARK_TEMPLATE(bm_is_node_by_name, gdwg::graph<std::string, int>);
+	BENCHMARK_TEMPLATE(bm_is_node_by_name, gdwg::unordered_graph<std::string, int>);
+
+	template<typename Graph>
+	void bm_insert_edge_by_name(benchmark::State& state) {
+		auto const& names = node_names();
+		for (auto _ : state) {
+			auto g = Graph(names.begin(), names.end());
+			for (auto n = std::size_t{0}; n < names.size(); ++n) {
+				for (auto d = std::size_t{1}; d <= 4; ++d) {
+					g.insert_edge(names[n], names[(n * 31 + d * 257) % names.size()], 1);
+				}
+			}
+			benchmark::DoNotOptimize(g);
+		}
+	}
+	BENCHMARK_TEMPLATE(bm_insert_edge_by_name, gdwg::graph<std::string, int>)
+	   ->Unit(benchmark::kMillisecond);
+	BENCHMARK_TEMPLATE(bm_insert_edge_by_name, gdwg::unordered_graph<std::string, int>)
+	   ->Unit(benchmark::kMillisecond);
+} // namespace
@@ -0,0 +1,190 @@
+#include "gdwg/graph.hpp"
+#include "gdwg/mapped_graph.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <ios>
+#include <map>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <streambuf>
+#include <vector>
+
+namespace {
+	using graph = gdwg::graph<int, double>;
+
+	constexpr auto out_degree = 4;
+
+	// Built once per size and shared by every benchmark in this file.
+	auto sized_graph(int num_nodes) -> graph const& {
+		static auto graphs = std::map<int, graph>{};
+		auto [it, inserted] = graphs.try_emplace(num_nodes);
+		if (inserted) {
+			auto nodes = std::vector<int>(static_cast<std::size_t>(num_nodes));
+			auto edges = std::vector<graph::value_type>{};
+			for (auto n = 0; n < num_nodes; ++n) {
+				nodes[static_cast<std::size_t>(n)] = n;
+				for (auto d = 1; d <= out_degree; ++d) {
+					edges.push_back({n, (n * 31 + d * 257) % num_nodes, 0.5 * d});
+				}
+			}
+			it->second.insert_nodes(nodes.begin(), nodes.end());
+			it->second.insert_edges(edges.begin(), edges.end());
+		}
+		return it->second;
+	}
+
+	// Counts what is written to it and throws it away, so only formatting is measured.
+	class counting_buffer : public std::streambuf {
+	public:
+		std::size_t written = 0;
+
+	protected:
+		auto overflow(int_type c) -> int_type override {
+			++written;
+			return traits_type::not_eof(c);
+		}
+
+		auto xsputn(char const*, std::streamsize n) -> std::streamsize override {
+			written += static_cast<std::size_t>(n);
+			return n;
+		}
+	};
+
+	void bm_print(benchmark::State& state) {
+		auto const& g = sized_graph(static_cast<int>(state.range(0)));
+		auto buffer = counting_buffer{};
+		auto os = std::ostream(&buffer);
+		for (auto _ : state) {
+			os << g;
+		}
+		state.SetBytesProcessed(static_cast<long>(buffer.written));
+	}
+	BENCHMARK(bm_print)->Arg(1 << 16)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+
+	// The same output as operator<<, but with one stream insertion per value.
+	void bm_print_insertions(benchmark::State& state) {
+		auto const& g = sized_graph(static_cast<int>(state.range(0)));
+		auto buffer = counting_buffer{};
+		auto os = std::ostream(&buffer);
+		for (auto _ : state) {
+			auto it = g.begin();
+			for (auto const& node : g.nodes_view()) {
+				os << node << " (\n";
+				for (; it != g.end() and (*it).from == node; ++it) {
+					os << "  " << (*it).to << " | " << (*it).weight << "\n";
+				}
+				os << ")\n";
+			}
+		}
+		state.SetBytesProcessed(static_cast<long>(buffer.written));
+	}
+	BENCHMARK(bm_print_insertions)->Arg(1 << 16)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+
+	void bm_save(benchmark::State& state) {
+		auto const& g = sized_graph(static_cast<int>(state.range(0)));
+		auto buffer = counting_buffer{};
+		auto os = std::ostream(&buffer);
+		for (auto _ : state) {
+			g.save(os);
+		}
+		state.SetBytesProcessed(static_cast<long>(buffer.written));
+	}
+	BENCHMARK(bm_save)->Arg(1 << 16)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+
+	void bm_load(benchmark::State& state) {
+		auto const& g = sized_graph(static_cast<int>(state.range(0)));
+		auto saved = std::ostringstream{};
+		g.save(saved);
+		auto const bytes = saved.str();
+		for (auto _ : state) {
+			state.PauseTiming();
+			auto is = std::istringstream(bytes);
+			auto loaded = graph{};
+			state.ResumeTiming();
+			loaded.load(is);
+			state.PauseTiming();
+			loaded.clear();
+			state.ResumeTiming();
+		}
+		state.SetBytesProcessed(state.iterations() * static_cast<long>(bytes.size()));
+	}
+	BENCHMARK(bm_load)->Arg(1 << 16)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+
+	// The edges of sized_graph as a text edge list.
+	auto edge_list_text(int num_nodes) -> std::string const& {
+		static auto texts = std::map<int, std::string>{};
+		auto [it, inserted] = texts.try_emplace(num_nodes);
+		if (inserted) {
+			auto out = std::ostringstream{};
+			for (auto const& [from, to, weight] : sized_graph(num_nodes)) {
+				out << from << ' ' << to << ' ' << weight << '\n';
+			}
+			it->second = out.str();
+		}
+		return it->second;
+	}
+
+	void bm_load_edge_list(benchmark::State& state) {
+		auto const& text = edge_list_text(static_cast<int>(state.range(0)));
+		for (auto _ : state) {
+			state.PauseTiming();
+			auto is = std::istringstream(text);
+			auto loaded = graph{};
+			state.ResumeTiming();
+			loaded.load_edge_list(is);
+			state.PauseTiming();
+			loaded.clear();
+			state.ResumeTiming();
+		}
+		state.SetBytesProcessed(state.iterations() * static_cast<long>(text.size()));
+	}
+	BENCHMARK(bm_load_edge_list)->Arg(1 << 16)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+
+	// The same edge list read with operator>> and inserted in bulk.
+	void bm_extract_edge_list(benchmark::State& state) {
+		auto const& text = edge_list_text(static_cast<int>(state.range(0)));
+		for (auto _ : state) {
+			state.PauseTiming();
+			auto is = std::istringstream(text);
+			auto loaded = graph{};
+			state.ResumeTiming();
+			auto edges = std::vector<graph::value_type>{};
+			auto nodes = std::vector<int>{};
+			for (auto e = graph::value_type{}; is >> e.from >> e.to >> e.weight;) {
+				edges.push_back(e);
+				nodes.push_back(e.from);
+				nodes.push_back(e.to);
+			}
+			loaded.insert_nodes(nodes.begin(), nodes.end());
+			loaded.insert_edges(edges.begin(), edges.end());
+			state.PauseTiming();
+			loaded.clear();
+			state.ResumeTiming();
+		}
+		state.SetBytesProcessed(state.iterations() * static_cast<long>(text.size()));
+	}
+	BENCHMARK(bm_extract_edge_list)->Arg(1 << 16)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+
+	// Opening a mapped file and answering one query, against bm_load's full rebuild.
+	void bm_map(benchmark::State& state) {
+		using mapped = gdwg::mapped_graph<int, double>;
+		auto const& g = sized_graph(static_cast<int>(state.range(0)));
+		auto const path = std::filesystem::temp_directory_path()
+		                  / ("graph_io_benchmark_" + std::to_string(state.range(0)) + ".csr");
+		{
+			auto file = std::ofstream(path, std::ios_base::binary);
+			mapped::write(g.freeze(), file);
+		}
+		for (auto _ : state) {
+			auto const m = mapped(path);
+			benchmark::DoNotOptimize(m.is_connected(0, out_degree));
+		}
+		std::filesystem::remove(path);
+	}
+	BENCHMARK(bm_map)->Arg(1 << 16)->Arg(1 << 20)->Unit(benchmark::kMicrosecond);
+} // namespace
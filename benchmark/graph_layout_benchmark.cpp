@@ -0,0 +1,192 @@
+#include "gdwg/graph.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <vector>
+
+// The same operations against every edge layout.
+namespace {
+	constexpr auto num_nodes = 1 << 14;
+	constexpr auto out_degree = 16;
+
+	template<typename Layout>
+	auto build() -> gdwg::graph<int, int, Layout> {
+		auto g = gdwg::graph<int, int, Layout>{};
+		for (auto n = 0; n < num_nodes; ++n) {
+			g.insert_node(n);
+		}
+		for (auto n = 0; n < num_nodes; ++n) {
+			for (auto d = 0; d < out_degree; ++d) {
+				g.insert_edge(n, (n * 31 + d * 257) % num_nodes, d);
+			}
+		}
+		return g;
+	}
+
+	// Out-degree falls off as 1 / rank: a few hubs with thousands of edges, and most nodes with
+	// one or two.
+	template<typename Layout>
+	auto build_power_law() -> gdwg::graph<int, int, Layout> {
+		auto g = gdwg::graph<int, int, Layout>{};
+		for (auto n = 0; n < num_nodes; ++n) {
+			g.insert_node(n);
+		}
+		for (auto n = 0; n < num_nodes; ++n) {
+			auto const degree = 1 + num_nodes / (8 * (n + 1));
+			for (auto d = 0; d < degree; ++d) {
+				g.insert_edge(n, static_cast<int>((n * 2654435761U + d * 40503U) % num_nodes), d);
+			}
+		}
+		return g;
+	}
+
+	// Built once per layout and shared by the read-only benchmarks.
+	template<typename Layout>
+	auto large_graph() -> gdwg::graph<int, int, Layout> const& {
+		static auto const g = build<Layout>();
+		return g;
+	}
+
+	template<typename Layout>
+	void bm_build(benchmark::State& state) {
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(build<Layout>());
+		}
+	}
+	BENCHMARK_TEMPLATE(bm_build, gdwg::layout::edge_tree)->Unit(benchmark::kMillisecond);
+	BENCHMARK_TEMPLATE(bm_build, gdwg::layout::adjacency)->Unit(benchmark::kMillisecond);
+	BENCHMARK_TEMPLATE(bm_build, gdwg::layout::interned<>)->Unit(benchmark::kMillisecond);
+	BENCHMARK_TEMPLATE(bm_build, gdwg::layout::interned<gdwg::layout::adjacency>)
+	   ->Unit(benchmark::kMillisecond);
+
+	template<typename Layout>
+	void bm_build_power_law(benchmark::State& state) {
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(build_power_law<Layout>());
+		}
+	}
+	BENCHMARK_TEMPLATE(bm_build_power_law, gdwg::layout::edge_tree)->Unit(benchmark::kMillisecond);
+	BENCHMARK_TEMPLATE(bm_build_power_law, gdwg::layout::adjacency)->Unit(benchmark::kMillisecond);
+	BENCHMARK_TEMPLATE(bm_build_power_law, gdwg::layout::interned<>)->Unit(benchmark::kMillisecond);
+	BENCHMARK_TEMPLATE(bm_build_power_law, gdwg::layout::interned<gdwg::layout::adjacency>)
+	   ->Unit(benchmark::kMillisecond);
+
+	// Every node's edges each way, as a traversal would ask for them.
+	template<typename Layout>
+	void bm_neighbours_power_law(benchmark::State& state) {
+		auto const g = build_power_law<Layout>();
+		for (auto _ : state) {
+			auto total = std::size_t{0};
+			for (auto n = 0; n < num_nodes; ++n) {
+				for (auto const id : g.connections(*g.id_of(n))) {
+					total += static_cast<std::size_t>(id);
+				}
+				total += g.incoming(*g.id_of(n)).size();
+			}
+			benchmark::DoNotOptimize(total);
+		}
+	}
+	BENCHMARK_TEMPLATE(bm_neighbours_power_law, gdwg::layout::edge_tree)
+	   ->Unit(benchmark::kMillisecond);
+	BENCHMARK_TEMPLATE(bm_neighbours_power_law, gdwg::layout::adjacency)
+	   ->Unit(benchmark::kMillisecond);
+	BENCHMARK_TEMPLATE(bm_neighbours_power_law, gdwg::layout::interned<>)
+	   ->Unit(benchmark::kMillisecond);
+	BENCHMARK_TEMPLATE(bm_neighbours_power_law, gdwg::layout::interned<gdwg::layout::adjacency>)
+	   ->Unit(benchmark::kMillisecond);
+
+	template<typename Layout>
+	void bm_is_connected(benchmark::State& state) {
+		auto const& g = large_graph<Layout>();
+		auto src = 0;
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(g.is_connected(src, (src * 31 + 257) % num_nodes));
+			src = (src + 7919) % num_nodes;
+		}
+	}
+	BENCHMARK_TEMPLATE(bm_is_connected, gdwg::layout::edge_tree);
+	BENCHMARK_TEMPLATE(bm_is_connected, gdwg::layout::adjacency);
+	BENCHMARK_TEMPLATE(bm_is_connected, gdwg::layout::interned<>);
+	BENCHMARK_TEMPLATE(bm_is_connected, gdwg::layout::interned<gdwg::layout::adjacency>);
+
+	template<typename Layout>
+	void bm_connections(benchmark::State& state) {
+		auto const& g = large_graph<Layout>();
+		auto src = 0;
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(g.connections(src));
+			src = (src + 7919) % num_nodes;
+		}
+	}
+	BENCHMARK_TEMPLATE(bm_connections, gdwg::layout::edge_tree);
+	BENCHMARK_TEMPLATE(bm_connections, gdwg::layout::adjacency);
+	BENCHMARK_TEMPLATE(bm_connections, gdwg::layout::interned<>);
+	BENCHMARK_TEMPLATE(bm_connections, gdwg::layout::interned<gdwg::layout::adjacency>);
+
+	template<typename Layout>
+	void bm_incoming(benchmark::State& state) {
+		auto const& g = large_graph<Layout>();
+		auto dst = 0;
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(g.incoming(dst));
+			dst = (dst + 7919) % num_nodes;
+		}
+	}
+	BENCHMARK_TEMPLATE(bm_incoming, gdwg::layout::edge_tree);
+	BENCHMARK_TEMPLATE(bm_incoming, gdwg::layout::adjacency);
+	BENCHMARK_TEMPLATE(bm_incoming, gdwg::layout::interned<>);
+	BENCHMARK_TEMPLATE(bm_incoming, gdwg::layout::interned<gdwg::layout::adjacency>);
+
+	template<typename Layout>
+	void bm_iterate(benchmark::State& state) {
+		auto const& g = large_graph<Layout>();
+		for (auto _ : state) {
+			auto sum = std::size_t{0};
+			for (auto const& [from, to, weight] : g) {
+				sum += static_cast<std::size_t>(weight);
+			}
+			benchmark::DoNotOptimize(sum);
+		}
+	}
+	BENCHMARK_TEMPLATE(bm_iterate, gdwg::layout::edge_tree)->Unit(benchmark::kMillisecond);
+	BENCHMARK_TEMPLATE(bm_iterate, gdwg::layout::adjacency)->Unit(benchmark::kMillisecond);
+	BENCHMARK_TEMPLATE(bm_iterate, gdwg::layout::interned<>)->Unit(benchmark::kMillisecond);
+	BENCHMARK_TEMPLATE(bm_iterate, gdwg::layout::interned<gdwg::layout::adjacency>)
+	   ->Unit(benchmark::kMillisecond);
+
+	// Erases every edge of a node and puts them back, so the graph is the same each iteration.
+	template<typename Layout>
+	void bm_erase_insert(benchmark::State& state) {
+		auto g = build<Layout>();
+		auto src = 0;
+		for (auto _ : state) {
+			for (auto d = 0; d < out_degree; ++d) {
+				g.erase_edge(src, (src * 31 + d * 257) % num_nodes, d);
+			}
+			for (auto d = 0; d < out_degree; ++d) {
+				g.insert_edge(src, (src * 31 + d * 257) % num_nodes, d);
+			}
+			src = (src + 7919) % num_nodes;
+		}
+	}
+	BENCHMARK_TEMPLATE(bm_erase_insert, gdwg::layout::edge_tree);
+	BENCHMARK_TEMPLATE(bm_erase_insert, gdwg::layout::adjacency);
+	BENCHMARK_TEMPLATE(bm_erase_insert, gdwg::layout::interned<>);
+	BENCHMARK_TEMPLATE(bm_erase_insert, gdwg::layout::interned<gdwg::layout::adjacency>);
+
+	template<typename Layout>
+	void bm_replace_node(benchmark::State& state) {
+		auto g = build<Layout>();
+		auto n = 0;
+		for (auto _ : state) {
+			g.replace_node(n, -1);
+			g.replace_node(-1, n);
+			n = (n + 7919) % num_nodes;
+		}
+	}
+	BENCHMARK_TEMPLATE(bm_replace_node, gdwg::layout::edge_tree);
+	BENCHMARK_TEMPLATE(bm_replace_node, gdwg::layout::adjacency);
+	BENCHMARK_TEMPLATE(bm_replace_node, gdwg::layout::interned<>);
+	BENCHMARK_TEMPLATE(bm_replace_node, gdwg::layout::interned<gdwg::layout::adjacency>);
+} // namespace
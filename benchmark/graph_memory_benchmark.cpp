@@ -0,0 +1,264 @@
+#include "gdwg/graph.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <numeric>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+
+// Every allocation in this program goes through these, so a benchmark can read off how many heap
+// blocks and bytes a data structure asked for.
+namespace {
+	auto allocated_blocks = std::size_t{0};
+	auto allocated_bytes = std::size_t{0};
+} // namespace
+
+auto operator new(std::size_t size) -> void* {
+	++allocated_blocks;
+	allocated_bytes += size;
+	if (auto* p = std::malloc(size == 0 ? 1 : size)) {
+		return p;
+	}
+	throw std::bad_alloc{};
+}
+
+auto operator delete(void* p) noexcept -> void {
+	std::free(p);
+}
+
+auto operator delete(void* p, std::size_t) noexcept -> void {
+	std::free(p);
+}
+
+auto operator new(std::size_t size, std::align_val_t align) -> void* {
+	++allocated_blocks;
+	allocated_bytes += size;
+	auto const a = static_cast<std::size_t>(align);
+	if (auto* p = std::aligned_alloc(a, (size + a - 1) / a * a)) {
+		return p;
+	}
+	throw std::bad_alloc{};
+}
+
+auto operator delete(void* p, std::align_val_t) noexcept -> void {
+	std::free(p);
+}
+
+auto operator delete(void* p, std::size_t, std::align_val_t) noexcept -> void {
+	std::free(p);
+}
+
+namespace {
+	// Short enough to fit in std::string's small buffer, so only the containers allocate.
+	auto node_name(long i) -> std::string {
+		return "n" + std::to_string(i);
+	}
+
+	struct shared_ptr_cmp {
+		auto operator()(std::shared_ptr<std::string> const& x,
+		                std::shared_ptr<std::string> const& y) const -> bool {
+			return *x < *y;
+		}
+	};
+
+	auto report(benchmark::State& state, std::size_t blocks, std::size_t bytes) -> void {
+		auto const n = static_cast<double>(state.range(0));
+		state.counters["allocs_per_node"] = static_cast<double>(blocks) / n;
+		state.counters["bytes_per_node"] = static_cast<double>(bytes) / n;
+	}
+
+	auto report_edges(benchmark::State& state, std::size_t blocks, std::size_t bytes) -> void {
+		auto const n = static_cast<double>(state.range(0));
+		state.counters["allocs_per_insert"] = static_cast<double>(blocks) / n;
+		state.counters["bytes_per_insert"] = static_cast<double>(bytes) / n;
+	}
+
+	// The layout graph started with: a set node and a make_shared block for every node.
+	void bm_nodes_shared_ptr_set(benchmark::State& state) {
+		auto blocks = std::size_t{0};
+		auto bytes = std::size_t{0};
+		for (auto _ : state) {
+			auto const blocks_before = allocated_blocks;
+			auto const bytes_before = allocated_bytes;
+			auto nodes = std::set<std::shared_ptr<std::string>, shared_ptr_cmp>{};
+			for (auto i = 0L; i < state.range(0); ++i) {
+				nodes.emplace(std::make_shared<std::string>(node_name(i)));
+			}
+			blocks = allocated_blocks - blocks_before;
+			bytes = allocated_bytes - bytes_before;
+		}
+		report(state, blocks, bytes);
+	}
+	BENCHMARK(bm_nodes_shared_ptr_set)->Arg(1 << 10)->Arg(1 << 20);
+
+	void bm_nodes_graph(benchmark::State& state) {
+		auto blocks = std::size_t{0};
+		auto bytes = std::size_t{0};
+		for (auto _ : state) {
+			auto const blocks_before = allocated_blocks;
+			auto const bytes_before = allocated_bytes;
+			auto g = gdwg::graph<std::string, int>{};
+			for (auto i = 0L; i < state.range(0); ++i) {
+				g.insert_node(node_name(i));
+			}
+			blocks = allocated_blocks - blocks_before;
+			bytes = allocated_bytes - bytes_before;
+		}
+		report(state, blocks, bytes);
+	}
+	BENCHMARK(bm_nodes_graph)->Arg(1 << 10)->Arg(1 << 20);
+
+	constexpr auto edge_nodes = 1 << 10;
+
+	struct legacy_edge {
+		int* src;
+		int* dst;
+		int weight;
+	};
+
+	struct legacy_edge_cmp {
+		auto operator()(std::shared_ptr<legacy_edge> const& x,
+		                std::shared_ptr<legacy_edge> const& y) const -> bool {
+			return std::tie(*(x->src), *(x->dst), x->weight) < std::tie(*(y->src), *(y->dst), y->weight);
+		}
+	};
+
+	// The layout graph started with: a set node and a make_shared block for every edge.
+	void bm_edges_shared_ptr_set(benchmark::State& state) {
+		auto ids = std::vector<int>(edge_nodes);
+		std::iota(ids.begin(), ids.end(), 0);
+		auto blocks = std::size_t{0};
+		auto bytes = std::size_t{0};
+		for (auto _ : state) {
+			auto edges = std::set<std::shared_ptr<legacy_edge>, legacy_edge_cmp>{};
+			auto const blocks_before = allocated_blocks;
+			auto const bytes_before = allocated_bytes;
+			for (auto i = 0L; i < state.range(0); ++i) {
+				auto* const src = &ids[static_cast<std::size_t>(i % edge_nodes)];
+				auto* const dst = &ids[static_cast<std::size_t>((i * 7) % edge_nodes)];
+				edges.emplace(std::make_shared<legacy_edge>(legacy_edge{src, dst, static_cast<int>(i)}));
+			}
+			blocks = allocated_blocks - blocks_before;
+			bytes = allocated_bytes - bytes_before;
+		}
+		report_edges(state, blocks, bytes);
+	}
+	BENCHMARK(bm_edges_shared_ptr_set)->Arg(1 << 20);
+
+	void bm_edges_graph(benchmark::State& state) {
+		auto blocks = std::size_t{0};
+		auto bytes = std::size_t{0};
+		for (auto _ : state) {
+			auto g = gdwg::graph<int, int>{};
+			for (auto n = 0; n < edge_nodes; ++n) {
+				g.insert_node(n);
+			}
+			auto const blocks_before = allocated_blocks;
+			auto const bytes_before = allocated_bytes;
+			for (auto i = 0L; i < state.range(0); ++i) {
+				g.insert_edge(static_cast<int>(i % edge_nodes),
+				              static_cast<int>((i * 7) % edge_nodes),
+				              static_cast<int>(i));
+			}
+			blocks = allocated_blocks - blocks_before;
+			bytes = allocated_bytes - bytes_before;
+		}
+		report_edges(state, blocks, bytes);
+	}
+	BENCHMARK(bm_edges_graph)->Arg(1 << 20);
+
+	// A few relationship labels, most too long for std::string's small buffer, on every edge.
+	template<typename Layout>
+	void bm_edges_labelled(benchmark::State& state) {
+		auto const labels = std::vector<std::string>{"depends_on",
+		                                             "transitively_depends_on",
+		                                             "is_maintained_by",
+		                                             "was_reviewed_by",
+		                                             "supersedes_the_design_of",
+		                                             "duplicates"};
+		auto blocks = std::size_t{0};
+		auto bytes = std::size_t{0};
+		for (auto _ : state) {
+			auto g = gdwg::graph<int, std::string, Layout>{};
+			for (auto n = 0; n < edge_nodes; ++n) {
+				g.insert_node(n);
+			}
+			auto const blocks_before = allocated_blocks;
+			auto const bytes_before = allocated_bytes;
+			for (auto i = 0L; i < state.range(0); ++i) {
+				g.insert_edge(static_cast<int>(i % edge_nodes),
+				              static_cast<int>((i / edge_nodes) % edge_nodes),
+				              labels[static_cast<std::size_t>(i) % labels.size()]);
+			}
+			blocks = allocated_blocks - blocks_before;
+			bytes = allocated_bytes - bytes_before;
+		}
+		report_edges(state, blocks, bytes);
+	}
+	BENCHMARK_TEMPLATE(bm_edges_labelled, gdwg::layout::edge_tree)->Arg(1 << 20);
+	BENCHMARK_TEMPLATE(bm_edges_labelled, gdwg::layout::interned<>)->Arg(1 << 20);
+
+	// Most nodes have one or two edges and a few have thousands, as in a power-law graph.
+	template<typename Layout>
+	void bm_edges_power_law(benchmark::State& state) {
+		auto const nodes = static_cast<int>(state.range(0));
+		auto blocks = std::size_t{0};
+		auto bytes = std::size_t{0};
+		auto edges = std::size_t{0};
+		for (auto _ : state) {
+			auto const blocks_before = allocated_blocks;
+			auto const bytes_before = allocated_bytes;
+			auto g = gdwg::graph<int, int, Layout>{};
+			for (auto n = 0; n < nodes; ++n) {
+				g.insert_node(n);
+			}
+			edges = 0;
+			for (auto n = 0; n < nodes; ++n) {
+				auto const degree = 1 + nodes / (8 * (n + 1));
+				for (auto d = 0; d < degree; ++d) {
+					auto const dst = static_cast<int>((n * 2654435761U + d * 40503U) % nodes);
+					edges += g.insert_edge(n, dst, d) ? 1 : 0;
+				}
+			}
+			blocks = allocated_blocks - blocks_before;
+			bytes = allocated_bytes - bytes_before;
+		}
+		auto const e = static_cast<double>(edges);
+		state.counters["allocs_per_edge"] = static_cast<double>(blocks) / e;
+		state.counters["bytes_per_edge"] = static_cast<double>(bytes) / e;
+	}
+	BENCHMARK_TEMPLATE(bm_edges_power_law, gdwg::layout::edge_tree)->Arg(1 << 18);
+	BENCHMARK_TEMPLATE(bm_edges_power_law, gdwg::layout::adjacency)->Arg(1 << 18);
+
+	// Node names too long for the small buffer: an iterator that copied them would allocate
+	// twice per edge.
+	void bm_iterate_long_names(benchmark::State& state) {
+		auto g = gdwg::graph<std::string, int>{};
+		auto const name = [](long i) { return std::string(32, 'x') + std::to_string(i); };
+		for (auto i = 0L; i < edge_nodes; ++i) {
+			g.insert_node(name(i));
+		}
+		for (auto i = 0L; i < state.range(0); ++i) {
+			g.insert_edge(name(i % edge_nodes), name((i * 7) % edge_nodes), static_cast<int>(i));
+		}
+		auto blocks = std::size_t{0};
+		for (auto _ : state) {
+			auto const blocks_before = allocated_blocks;
+			auto total = std::size_t{0};
+			for (auto const& [from, to, weight] : g) {
+				total += from.size() + to.size();
+			}
+			benchmark::DoNotOptimize(total);
+			blocks = allocated_blocks - blocks_before;
+		}
+		state.counters["allocs_per_edge"] =
+		   static_cast<double>(blocks) / static_cast<double>(state.range(0));
+	}
+	BENCHMARK(bm_iterate_long_names)->Arg(1 << 16);
+} // namespace
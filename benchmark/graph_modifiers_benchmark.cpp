@@ -0,0 +1,142 @@
+#include "gdwg/graph.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <numeric>
+#include <vector>
+
+namespace {
+	using graph = gdwg::graph<int, int>;
+
+	auto make_graph(int num_nodes, int out_degree) -> graph {
+		auto g = graph{};
+		for (auto n = 0; n < num_nodes; ++n) {
+			g.insert_node(n);
+		}
+		for (auto n = 0; n < num_nodes; ++n) {
+			for (auto d = 0; d < out_degree; ++d) {
+				g.insert_edge(n, (n + d) % num_nodes, d);
+			}
+		}
+		return g;
+	}
+
+	// Every other edge of the graph, in a scattered order.
+	auto churn_batch(int num_nodes, int out_degree) -> std::vector<graph::value_type> {
+		auto v = std::vector<graph::value_type>{};
+		for (auto d = 0; d < out_degree; d += 2) {
+			for (auto n = 0; n < num_nodes; ++n) {
+				v.push_back({n, (n + d) % num_nodes, d});
+			}
+		}
+		return v;
+	}
+
+	void bm_erase_edge_loop(benchmark::State& state) {
+		auto const num_nodes = static_cast<int>(state.range(0));
+		auto const batch = churn_batch(num_nodes, 16);
+		auto g = graph{};
+		for (auto _ : state) {
+			state.PauseTiming();
+			g = make_graph(num_nodes, 16);
+			state.ResumeTiming();
+			for (auto const& [from, to, weight] : batch) {
+				g.erase_edge(from, to, weight);
+			}
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<long>(batch.size()));
+	}
+	BENCHMARK(bm_erase_edge_loop)->Arg(1 << 12)->Arg(1 << 16);
+
+	void bm_erase_edges_batch(benchmark::State& state) {
+		auto const num_nodes = static_cast<int>(state.range(0));
+		auto const batch = churn_batch(num_nodes, 16);
+		auto g = graph{};
+		for (auto _ : state) {
+			state.PauseTiming();
+			g = make_graph(num_nodes, 16);
+			state.ResumeTiming();
+			benchmark::DoNotOptimize(g.erase_edges(batch.begin(), batch.end()));
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<long>(batch.size()));
+	}
+	BENCHMARK(bm_erase_edges_batch)->Arg(1 << 12)->Arg(1 << 16);
+
+	// Loading a graph from an edge list: one insert_edge() per edge against one bulk insert_edges().
+	auto edge_list(int num_nodes, int out_degree) -> std::vector<graph::value_type> {
+		auto v = std::vector<graph::value_type>{};
+		for (auto d = 0; d < out_degree; ++d) {
+			for (auto n = 0; n < num_nodes; ++n) {
+				v.push_back({(n * 7919) % num_nodes, (n + d * 31) % num_nodes, d});
+			}
+		}
+		return v;
+	}
+
+	auto node_list(int num_nodes) -> std::vector<int> {
+		auto v = std::vector<int>(static_cast<std::size_t>(num_nodes));
+		std::iota(v.begin(), v.end(), 0);
+		return v;
+	}
+
+	void bm_load_insert_edge_loop(benchmark::State& state) {
+		auto const num_nodes = static_cast<int>(state.range(0));
+		auto const nodes = node_list(num_nodes);
+		auto const edges = edge_list(num_nodes, 16);
+		for (auto _ : state) {
+			auto g = graph{};
+			for (auto const n : nodes) {
+				g.insert_node(n);
+			}
+			for (auto const& [from, to, weight] : edges) {
+				g.insert_edge(from, to, weight);
+			}
+			state.PauseTiming();
+			g = graph{};
+			state.ResumeTiming();
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<long>(edges.size()));
+	}
+	BENCHMARK(bm_load_insert_edge_loop)->Arg(1 << 16)->Unit(benchmark::kMillisecond);
+
+	void bm_load_insert_edges_bulk(benchmark::State& state) {
+		auto const num_nodes = static_cast<int>(state.range(0));
+		auto const nodes = node_list(num_nodes);
+		auto const edges = edge_list(num_nodes, 16);
+		for (auto _ : state) {
+			auto g = graph{};
+			g.insert_nodes(nodes.begin(), nodes.end());
+			g.insert_edges(edges.begin(), edges.end());
+			state.PauseTiming();
+			g = graph{};
+			state.ResumeTiming();
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<long>(edges.size()));
+	}
+	BENCHMARK(bm_load_insert_edges_bulk)->Arg(1 << 16)->Unit(benchmark::kMillisecond);
+
+	// Snapshotting a graph for a reader: the copy shares the original's storage.
+	void bm_copy(benchmark::State& state) {
+		auto const g = make_graph(static_cast<int>(state.range(0)), 16);
+		for (auto _ : state) {
+			auto copy = g;
+			benchmark::DoNotOptimize(copy);
+		}
+	}
+	BENCHMARK(bm_copy)->Arg(1 << 16);
+
+	// The first write after a snapshot pays for the deep copy; later writes don't.
+	void bm_copy_then_write(benchmark::State& state) {
+		auto g = make_graph(static_cast<int>(state.range(0)), 16);
+		for (auto _ : state) {
+			auto const snapshot = g;
+			g.insert_edge(0, 1, -1);
+			g.erase_edge(0, 1, -1);
+			state.PauseTiming();
+			benchmark::DoNotOptimize(snapshot);
+			state.ResumeTiming();
+		}
+	}
+	BENCHMARK(bm_copy_then_write)->Arg(1 << 16)->Unit(benchmark::kMillisecond);
+} // namespace
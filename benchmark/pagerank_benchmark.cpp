@@ -0,0 +1,92 @@
+#include "gdwg/graph.hpp"
+#include "gdwg/pagerank.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <thread>
+#include <vector>
+
+// Ranks R-MAT graphs, the power-law generator used by Graph500, of 2^scale nodes and 16 edges
+// per node.
+namespace {
+	constexpr auto edge_factor = 16;
+
+	using rmat_graph = gdwg::graph<int, int, gdwg::layout::adjacency>;
+
+	auto build_rmat(int scale) -> rmat_graph {
+		auto const num_nodes = 1 << scale;
+		auto g = rmat_graph{};
+		for (auto n = 0; n < num_nodes; ++n) {
+			g.insert_node(n);
+		}
+		auto rng = std::mt19937(1);
+		auto quadrant = std::uniform_real_distribution<double>(0, 1);
+		for (auto i = 0; i < num_nodes * edge_factor; ++i) {
+			auto src = 0;
+			auto dst = 0;
+			for (auto bit = 0; bit < scale; ++bit) {
+				auto const q = quadrant(rng);
+				src |= (q >= 0.76 ? 1 : 0) << bit;
+				dst |= ((q >= 0.57 and q < 0.76) or q >= 0.95 ? 1 : 0) << bit;
+			}
+			g.insert_edge(src, dst, 0);
+		}
+		return g;
+	}
+
+	auto rmat(int scale) -> rmat_graph const& {
+		static auto graphs = std::vector<rmat_graph>(32);
+		if (graphs[static_cast<std::size_t>(scale)].empty()) {
+			graphs[static_cast<std::size_t>(scale)] = build_rmat(scale);
+		}
+		return graphs[static_cast<std::size_t>(scale)];
+	}
+
+	void bm_pagerank(benchmark::State& state) {
+		auto const g = rmat(static_cast<int>(state.range(0))).freeze();
+		auto const threads = static_cast<unsigned>(state.range(1));
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(gdwg::pagerank(g, 0.85, 1e-6, threads));
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(g.num_edges()));
+	}
+	BENCHMARK(bm_pagerank)
+	   ->ArgsProduct({{14, 17}, {1, std::max(1U, std::thread::hardware_concurrency())}})
+	   ->Unit(benchmark::kMillisecond)
+	   ->UseRealTime();
+
+	// The same iteration pushed along the graph's own edges, one connections() per node.
+	void bm_pagerank_connections(benchmark::State& state) {
+		auto const& g = rmat(static_cast<int>(state.range(0)));
+		auto const n = static_cast<double>(g.id_bound());
+		for (auto _ : state) {
+			auto rank = std::vector<double>(g.id_bound(), 1 / n);
+			for (auto change = 1.0; change >= 1e-6;) {
+				auto next = std::vector<double>(g.id_bound(), 0);
+				auto dangling = 0.0;
+				for (auto u = std::size_t{0}; u < g.id_bound(); ++u) {
+					auto const out = g.connections(static_cast<rmat_graph::node_id>(u));
+					if (out.empty()) {
+						dangling += rank[u];
+					}
+					for (auto const v : out) {
+						next[static_cast<std::size_t>(v)] += rank[u] / static_cast<double>(out.size());
+					}
+				}
+				change = 0;
+				for (auto v = std::size_t{0}; v < next.size(); ++v) {
+					next[v] = 0.15 / n + 0.85 * (next[v] + dangling / n);
+					change += std::abs(next[v] - rank[v]);
+				}
+				rank = std::move(next);
+			}
+			benchmark::DoNotOptimize(rank);
+		}
+	}
+	BENCHMARK(bm_pagerank_connections)->Arg(14)->Unit(benchmark::kMillisecond);
+} // namespace
@@ -0,0 +1,96 @@
+#include "gdwg/graph.hpp"
+#include "gdwg/shortest_paths.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+#include <vector>
+
+// Road networks are close to planar grids with a handful of edges per junction, so these run on
+// a side x side grid with a road each way between neighbours and a random length on every road.
+namespace {
+	constexpr auto side = 512;
+
+	template<typename Layout>
+	auto build_grid() -> gdwg::graph<int, int, Layout> {
+		auto g = gdwg::graph<int, int, Layout>{};
+		for (auto n = 0; n < side * side; ++n) {
+			g.insert_node(n);
+		}
+		auto length = std::uint32_t{1};
+		auto const road = [&g, &length](int from, int to) {
+			length = length * 1664525U + 1013904223U;
+			auto const w = static_cast<int>(1 + (length >> 16) % 1000);
+			g.insert_edge(from, to, w);
+			g.insert_edge(to, from, w);
+		};
+		for (auto y = 0; y < side; ++y) {
+			for (auto x = 0; x < side; ++x) {
+				auto const n = y * side + x;
+				if (x + 1 < side) {
+					road(n, n + 1);
+				}
+				if (y + 1 < side) {
+					road(n, n + side);
+				}
+			}
+		}
+		return g;
+	}
+
+	template<typename Layout>
+	auto grid() -> gdwg::graph<int, int, Layout> const& {
+		static auto const g = build_grid<Layout>();
+		return g;
+	}
+
+	template<typename Layout>
+	void bm_shortest_paths(benchmark::State& state) {
+		auto const& g = grid<Layout>();
+		auto source = 0;
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(gdwg::shortest_paths(g, source));
+			source = (source + 7919) % (side * side);
+		}
+		state.SetItemsProcessed(state.iterations() * side * side);
+	}
+	BENCHMARK_TEMPLATE(bm_shortest_paths, gdwg::layout::edge_tree)->Unit(benchmark::kMillisecond);
+	BENCHMARK_TEMPLATE(bm_shortest_paths, gdwg::layout::adjacency)->Unit(benchmark::kMillisecond);
+
+	// Dijkstra as written against the value-based interface: connections() and weights() for
+	// every node, and a binary heap with duplicate entries instead of decrease-key.
+	void bm_shortest_paths_by_value(benchmark::State& state) {
+		auto const& g = grid<gdwg::layout::edge_tree>();
+		auto source = 0;
+		for (auto _ : state) {
+			auto distance = std::vector<int>(side * side, std::numeric_limits<int>::max());
+			using entry = std::pair<int, int>;
+			auto heap = std::priority_queue<entry, std::vector<entry>, std::greater<>>{};
+			distance[static_cast<std::size_t>(source)] = 0;
+			heap.emplace(0, source);
+			while (not heap.empty()) {
+				auto const [d, u] = heap.top();
+				heap.pop();
+				if (d > distance[static_cast<std::size_t>(u)]) {
+					continue;
+				}
+				for (auto const v : g.connections(u)) {
+					auto const through = d + g.weights(u, v).front();
+					if (through < distance[static_cast<std::size_t>(v)]) {
+						distance[static_cast<std::size_t>(v)] = through;
+						heap.emplace(through, v);
+					}
+				}
+			}
+			benchmark::DoNotOptimize(distance);
+			source = (source + 7919) % (side * side);
+		}
+		state.SetItemsProcessed(state.iterations() * side * side);
+	}
+	BENCHMARK(bm_shortest_paths_by_value)->Unit(benchmark::kMillisecond);
+} // namespace
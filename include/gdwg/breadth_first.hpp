@@ -0,0 +1,260 @@
+#ifndef GDWG_BREADTH_FIRST_HPP
+#define GDWG_BREADTH_FIRST_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "gdwg/frozen_graph.hpp"
+#include "gdwg/parallel.hpp"
+
+namespace gdwg {
+	// Direction-optimizing breadth-first search over a frozen_graph, split across threads.
+	//
+	// A level is expanded top-down, each frontier node claiming its unvisited successors, while
+	// the frontier is small. Once the edges leaving it outnumber those left to check by alpha,
+	// levels go bottom-up instead: every unvisited node looks through its predecessors for one in
+	// the frontier and stops at the first, which skips most edges of a large frontier. Top-down
+	// frontiers are a queue of node indices; bottom-up ones are a bitmap with a bit per node.
+	//
+	// Bottom-up needs every node's predecessors, so construction builds the reverse of the
+	// snapshot's rows once, in O(n + e); each search after that reuses it. The snapshot has to
+	// outlive this object.
+	template<typename N, typename E>
+	class breadth_first {
+	public:
+		using index_type = typename frozen_graph<N, E>::index_type;
+
+		// The depth of a node the source can't reach.
+		static constexpr auto unreached = std::numeric_limits<std::uint32_t>::max();
+
+		explicit breadth_first(frozen_graph<N, E> const& g,
+		                       unsigned threads = detail::default_threads())
+		: g_{&g}
+		, threads_{std::max(1U, threads)}
+		, in_{detail::reverse(g)} {}
+
+		// Number of edges on a shortest path from source to each node, by node index, or
+		// unreached.
+		[[nodiscard]] auto depths(std::size_t source) const -> std::vector<std::uint32_t> {
+			if (source >= g_->num_nodes()) {
+				throw std::runtime_error("Cannot call gdwg::breadth_first<N, E>::depths if source "
+				                         "isn't a node of the graph");
+			}
+			auto s = search(*this, source);
+			detail::run_threads(threads_, [&s](unsigned) { s.work(); });
+			return std::move(s.depth);
+		}
+
+	private:
+		using word = std::uint64_t;
+		static constexpr auto word_bits = std::size_t{64};
+
+		// Switch to bottom-up once the frontier's edges are more than 1 / alpha of those left;
+		// back to top-down once the frontier shrinks below 1 / beta of the nodes.
+		static constexpr auto alpha = std::size_t{14};
+		static constexpr auto beta = std::size_t{24};
+		// Frontier nodes a thread takes at a time top-down, and words of the bitmap bottom-up.
+		static constexpr auto queue_chunk = std::size_t{64};
+		static constexpr auto bitmap_chunk = std::size_t{16};
+
+		frozen_graph<N, E> const* g_;
+		unsigned threads_;
+		detail::reverse_rows<index_type> in_;
+
+		// One search. Threads expand a level together, then wait at a barrier whose completion,
+		// run by the last to arrive, picks the direction of the next level and sets it up.
+		struct search {
+			breadth_first const& bfs;
+			std::size_t num_nodes;
+			std::vector<std::uint32_t> depth;
+			// Top-down frontier, and the next one as threads add to it.
+			std::vector<index_type> queue;
+			std::vector<index_type> next_queue;
+			std::size_t queue_size = 0;
+			std::atomic<std::size_t> next_size = 0;
+			// Bottom-up frontier and the next one, a bit per node. Each thread writes whole words
+			// of next_bits.
+			std::vector<word> bits;
+			std::vector<word> next_bits;
+
+			std::atomic<std::size_t> cursor = 0;
+			// Out-edges of the nodes found this level, and how many nodes those were.
+			std::atomic<std::size_t> scout = 0;
+			std::atomic<std::size_t> awake = 0;
+			std::size_t previous_awake = 0;
+			std::size_t edges_to_check;
+			std::uint32_t level = 0;
+			bool bottom_up = false;
+			bool done = false;
+
+			struct finish_level {
+				search* s;
+
+				auto operator()() const noexcept -> void {
+					s->advance();
+				}
+			};
+
+			std::barrier<finish_level> sync;
+
+			search(breadth_first const& b, std::size_t source)
+			: bfs{b}
+			, num_nodes{b.g_->num_nodes()}
+			, depth(num_nodes, unreached)
+			, queue(num_nodes)
+			, next_queue(num_nodes)
+			, bits((num_nodes + word_bits - 1) / word_bits)
+			, next_bits(bits.size())
+			, edges_to_check{b.g_->num_edges()}
+			, sync{static_cast<std::ptrdiff_t>(b.threads_), finish_level{this}} {
+				depth[source] = 0;
+				queue[0] = static_cast<index_type>(source);
+				queue_size = 1;
+			}
+
+			auto work() -> void {
+				auto found = std::vector<index_type>{};
+				while (not done) {
+					if (bottom_up) {
+						expand_bottom_up();
+					}
+					else {
+						expand_top_down(found);
+					}
+					sync.arrive_and_wait();
+				}
+			}
+
+			auto expand_top_down(std::vector<index_type>& found) -> void {
+				auto const& g = *bfs.g_;
+				auto const next = level + 1;
+				auto edges = std::size_t{0};
+				for (;;) {
+					auto const first = cursor.fetch_add(queue_chunk, std::memory_order_relaxed);
+					if (first >= queue_size) {
+						break;
+					}
+					auto const last = std::min(first + queue_chunk, queue_size);
+					for (auto i = first; i < last; ++i) {
+						for (auto const v : g.targets(queue[i])) {
+							auto d = std::atomic_ref<std::uint32_t>(depth[v]);
+							auto expected = unreached;
+							if (d.load(std::memory_order_relaxed) == unreached
+							    and d.compare_exchange_strong(expected, next, std::memory_order_relaxed))
+							{
+								found.push_back(v);
+								edges += g.out_degree(v);
+							}
+						}
+					}
+				}
+				auto const at = next_size.fetch_add(found.size(), std::memory_order_relaxed);
+				std::copy(found.begin(),
+				          found.end(),
+				          next_queue.begin() + static_cast<std::ptrdiff_t>(at));
+				found.clear();
+				scout.fetch_add(edges, std::memory_order_relaxed);
+			}
+
+			auto expand_bottom_up() -> void {
+				auto const& g = *bfs.g_;
+				auto const next = level + 1;
+				auto const num_words = bits.size();
+				// Held in locals, as the compiler can't tell that writing depth leaves them be.
+				auto const* const offsets = bfs.in_.offsets.data();
+				auto const* const sources = bfs.in_.sources.data();
+				auto const* const front = bits.data();
+				auto* const d = depth.data();
+				auto edges = std::size_t{0};
+				auto nodes = std::size_t{0};
+				for (;;) {
+					auto const first = cursor.fetch_add(bitmap_chunk, std::memory_order_relaxed);
+					if (first >= num_words) {
+						break;
+					}
+					auto const last = std::min(first + bitmap_chunk, num_words);
+					for (auto w = first; w < last; ++w) {
+						auto out = word{0};
+						auto const end = std::min((w + 1) * word_bits, num_nodes);
+						for (auto v = w * word_bits; v < end; ++v) {
+							if (d[v] != unreached) {
+								continue;
+							}
+							for (auto i = offsets[v]; i < offsets[v + 1]; ++i) {
+								auto const u = sources[i];
+								if ((front[u / word_bits] >> (u % word_bits)) & 1U) {
+									d[v] = next;
+									out |= word{1} << (v % word_bits);
+									edges += g.out_degree(v);
+									++nodes;
+									break;
+								}
+							}
+						}
+						next_bits[w] = out;
+					}
+				}
+				scout.fetch_add(edges, std::memory_order_relaxed);
+				awake.fetch_add(nodes, std::memory_order_relaxed);
+			}
+
+			// Run alone between levels. Every buffer is already allocated, so nothing here throws.
+			auto advance() noexcept -> void {
+				++level;
+				cursor.store(0, std::memory_order_relaxed);
+				auto const found_edges = scout.exchange(0, std::memory_order_relaxed);
+				if (not bottom_up) {
+					std::swap(queue, next_queue);
+					queue_size = next_size.exchange(0, std::memory_order_relaxed);
+					edges_to_check -= std::min(edges_to_check, found_edges);
+					if (queue_size == 0) {
+						done = true;
+					}
+					else if (found_edges > edges_to_check / alpha) {
+						to_bitmap();
+					}
+				}
+				else {
+					std::swap(bits, next_bits);
+					auto const found = awake.exchange(0, std::memory_order_relaxed);
+					if (found == 0) {
+						done = true;
+					}
+					else if (found < previous_awake and found < num_nodes / beta) {
+						to_queue();
+					}
+					previous_awake = found;
+				}
+			}
+
+			auto to_bitmap() noexcept -> void {
+				std::fill(bits.begin(), bits.end(), word{0});
+				for (auto i = std::size_t{0}; i < queue_size; ++i) {
+					bits[queue[i] / word_bits] |= word{1} << (queue[i] % word_bits);
+				}
+				previous_awake = queue_size;
+				bottom_up = true;
+			}
+
+			auto to_queue() noexcept -> void {
+				queue_size = 0;
+				for (auto w = std::size_t{0}; w < bits.size(); ++w) {
+					for (auto b = bits[w]; b != 0; b &= b - 1) {
+						auto const v = w * word_bits + static_cast<std::size_t>(std::countr_zero(b));
+						queue[queue_size++] = static_cast<index_type>(v);
+					}
+				}
+				bottom_up = false;
+			}
+		};
+	};
+} // namespace gdwg
+
+#endif // GDWG_BREADTH_FIRST_HPP
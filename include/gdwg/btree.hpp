@@ -0,0 +1,911 @@
+#ifndef GDWG_BTREE_HPP
+#define GDWG_BTREE_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "gdwg/pool.hpp"
+
+namespace gdwg::detail {
+	// Sorted sequence in a B+ tree of reference-counted nodes that copies share: copying a tree
+	// is O(1), and a modifier copies only the nodes on its path from the root that another tree
+	// also holds, O(log n) of them. The tree keeps no comparator. Lookups take one, which must
+	// compare T with the key both ways, and insert() takes a position, which must keep the
+	// sequence sorted; equal elements are allowed. Every inner node counts the elements under
+	// each child, so a position is also a rank: at() and index() are O(log n) and O(1), and an
+	// iterator steps to the next leaf by searching for its rank.
+	//
+	// Elements move within and between leaves, so T must be nothrow movable. A modifier
+	// invalidates every iterator and reference into the tree. insert() and erase() either
+	// succeed or throw having changed nothing.
+	//
+	// Nodes come from the tree's arena, which copies share, so that a tree and its copies free
+	// their nodes into the arena they came from.
+	template<typename T>
+	class btree {
+		static_assert(std::is_nothrow_move_constructible_v<T>
+		              and std::is_nothrow_move_assignable_v<T>);
+
+	public:
+		class iterator;
+		using value_type = T;
+		using const_iterator = iterator;
+
+		btree() noexcept = default;
+
+		explicit btree(node_arena arena) noexcept
+		: arena_{std::move(arena)} {}
+
+		btree(btree const& other) noexcept
+		: root_{other.root_}
+		, size_{other.size_}
+		, height_{other.height_}
+		, arena_{other.arena_} {
+			if (root_ != nullptr) {
+				root_->refs.fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+
+		btree(btree&& other) noexcept
+		: root_{std::exchange(other.root_, nullptr)}
+		, size_{std::exchange(other.size_, 0)}
+		, height_{std::exchange(other.height_, 0)}
+		, arena_{other.arena_} {}
+
+		auto operator=(btree const& other) noexcept -> btree& {
+			auto copy = other;
+			swap(copy);
+			return *this;
+		}
+
+		auto operator=(btree&& other) noexcept -> btree& {
+			swap(other);
+			return *this;
+		}
+
+		~btree() {
+			release(root_, height_);
+		}
+
+		auto swap(btree& other) noexcept -> void {
+			std::swap(root_, other.root_);
+			std::swap(size_, other.size_);
+			std::swap(height_, other.height_);
+			arena_.swap(other.arena_);
+		}
+
+		[[nodiscard]] auto size() const noexcept -> std::size_t {
+			return size_;
+		}
+
+		[[nodiscard]] auto empty() const noexcept -> bool {
+			return size_ == 0;
+		}
+
+		[[nodiscard]] auto begin() const -> iterator {
+			return at(0);
+		}
+
+		[[nodiscard]] auto end() const noexcept -> iterator {
+			return iterator{this, nullptr, 0, size_};
+		}
+
+		// The element of rank i, or end() if there is none. log(n)
+		[[nodiscard]] auto at(std::size_t i) const -> iterator {
+			if (i >= size_) {
+				return end();
+			}
+			auto const rank = i;
+			auto const* n = root_;
+			for (auto h = height_; h > 0; --h) {
+				auto const* in = as_inner(n);
+				auto j = std::uint32_t{0};
+				while (i >= in->counts[j]) {
+					i -= in->counts[j];
+					++j;
+				}
+				n = in->children[j];
+			}
+			return iterator{this, as_leaf(n), static_cast<std::uint32_t>(i), rank};
+		}
+
+		// The first element not less than key.
+		template<typename K, typename Compare>
+		[[nodiscard]] auto lower_bound(K const& key, Compare cmp) const -> iterator {
+			return search([&key, &cmp](T const& x) { return cmp(x, key); });
+		}
+
+		// The first element greater than key.
+		template<typename K, typename Compare>
+		[[nodiscard]] auto upper_bound(K const& key, Compare cmp) const -> iterator {
+			return search([&key, &cmp](T const& x) { return not cmp(key, x); });
+		}
+
+		template<typename K, typename Compare>
+		[[nodiscard]] auto equal_range(K const& key, Compare cmp) const
+		   -> std::pair<iterator, iterator> {
+			return {lower_bound(key, cmp), upper_bound(key, cmp)};
+		}
+
+		template<typename K, typename Compare>
+		[[nodiscard]] auto find(K const& key, Compare cmp) const -> iterator {
+			auto const it = lower_bound(key, cmp);
+			return it == end() or cmp(key, *it) ? end() : it;
+		}
+
+		template<typename K, typename Compare>
+		[[nodiscard]] auto contains(K const& key, Compare cmp) const -> bool {
+			return find(key, cmp) != end();
+		}
+
+		// Puts value at rank i, before the element there, and returns an iterator to it.
+		auto insert(std::size_t i, T value) -> iterator {
+			assert(i <= size_);
+			reserve_root();
+			auto const rank = i;
+			auto path = std::array<inner*, max_height>{};
+			auto slots = std::array<std::uint32_t, max_height>{};
+			// The one level, if any, where value goes first into a child other than the first,
+			// so that the key in front of that child has to become value.
+			inner* key_node = nullptr;
+			auto key_slot = std::uint32_t{0};
+			auto** slot = &root_;
+			// Elements under *slot, so that appending needn't walk the counts.
+			auto under = size_;
+			for (auto h = height_; h > 0; --h) {
+				auto* const in = as_inner(*slot);
+				auto j = std::uint32_t{0};
+				if (i == under) {
+					j = in->count - 1;
+					i = in->counts[j];
+				}
+				else {
+					while (j + 1 < in->count and i >= in->counts[j]) {
+						i -= in->counts[j];
+						++j;
+					}
+				}
+				own(in->children[j], h - 1);
+				if (full(in->children[j], h - 1)) {
+					split(in, j, i, h - 1);
+					if (i >= in->counts[j]) {
+						i -= in->counts[j];
+						++j;
+					}
+				}
+				if (i == 0 and j > 0) {
+					key_node = in;
+					key_slot = j;
+				}
+				path[height_ - h] = in;
+				slots[height_ - h] = j;
+				slot = &in->children[j];
+				under = in->counts[j];
+			}
+
+			auto key = std::optional<T>{};
+			if (key_node != nullptr) {
+				key.emplace(value);
+			}
+			auto* const l = as_leaf(*slot);
+			insert_item(l, static_cast<std::uint32_t>(i), std::move(value));
+			if (key_node != nullptr) {
+				key_node->key(key_slot) = std::move(*key);
+			}
+			for (auto d = std::uint32_t{0}; d < height_; ++d) {
+				++path[d]->counts[slots[d]];
+			}
+			++size_;
+			return iterator{this, l, static_cast<std::uint32_t>(i), rank};
+		}
+
+		auto insert(iterator pos, T value) -> iterator {
+			return insert(pos.index(), std::move(value));
+		}
+
+		auto push_back(T value) -> void {
+			insert(size_, std::move(value));
+		}
+
+		// Makes the nodes on the path to rank i this tree's own, so that erasing that element
+		// straight after can't throw unless copying T can.
+		auto own(std::size_t i) -> void {
+			auto path = std::array<inner*, max_height>{};
+			auto slots = std::array<std::uint32_t, max_height>{};
+			own_path(i, path, slots);
+		}
+
+		// Erases the element of rank i. Throws only before changing anything: after own(i), only
+		// if the element was first in its leaf and copying the next one into a key throws. A leaf
+		// left empty is taken out at once; nodes left underfull are merged with or filled from a
+		// sibling where that can be done without throwing.
+		auto erase(std::size_t i) -> void {
+			assert(i < size_);
+			auto path = std::array<inner*, max_height>{};
+			auto slots = std::array<std::uint32_t, max_height>{};
+			auto* const l = own_path(i, path, slots);
+			// The one level, if any, whose key is a copy of the element, as the deepest level
+			// where the element isn't under the first child.
+			inner* key_node = nullptr;
+			auto key_slot = std::uint32_t{0};
+			if (i == 0) {
+				for (auto d = height_; d > 0 and key_node == nullptr; --d) {
+					if (slots[d - 1] > 0) {
+						key_node = path[d - 1];
+						key_slot = slots[d - 1];
+					}
+				}
+			}
+			if (l->count == 1 and height_ > 0) {
+				erase_leaf(path, slots, key_node, key_slot);
+				return;
+			}
+			auto key = std::optional<T>{};
+			if (key_node != nullptr) {
+				key.emplace(l->items()[1]);
+			}
+			erase_item(l, static_cast<std::uint32_t>(i));
+			if (key_node != nullptr) {
+				key_node->key(key_slot) = std::move(*key);
+			}
+			for (auto d = std::uint32_t{0}; d < height_; ++d) {
+				--path[d]->counts[slots[d]];
+			}
+			--size_;
+			rebalance(path, slots, height_);
+		}
+
+		auto erase(iterator pos) -> void {
+			erase(pos.index());
+		}
+
+		auto clear() noexcept -> void {
+			release(std::exchange(root_, nullptr), std::exchange(height_, 0));
+			size_ = 0;
+		}
+
+	private:
+		static constexpr auto fanout = std::uint32_t{32};
+		static constexpr auto max_height = std::uint32_t{32};
+		// Leaves hold about a kilobyte. A root leaf starts smaller and doubles as it fills, so a
+		// tree of a few elements stays small.
+		static constexpr auto leaf_capacity =
+		   static_cast<std::uint32_t>(std::clamp(std::size_t{1024} / sizeof(T), std::size_t{8},
+		                                         std::size_t{128}));
+		static constexpr auto first_capacity = std::uint32_t{4};
+
+		struct node {
+			std::atomic<std::uint32_t> refs = 1;
+			// Elements in a leaf, children in an inner node.
+			std::uint32_t count = 0;
+		};
+
+		// Followed in the same allocation by room for capacity elements.
+		struct leaf : node {
+			std::uint32_t capacity;
+
+			explicit leaf(std::uint32_t cap) noexcept
+			: capacity{cap} {}
+
+			auto items() noexcept -> T* {
+				return reinterpret_cast<T*>(reinterpret_cast<std::byte*>(this) + items_offset);
+			}
+
+			auto items() const noexcept -> T const* {
+				return reinterpret_cast<T const*>(reinterpret_cast<std::byte const*>(this)
+				                                  + items_offset);
+			}
+		};
+
+		static constexpr auto items_offset = (sizeof(leaf) + alignof(T) - 1) / alignof(T)
+		                                     * alignof(T);
+		static constexpr auto leaf_alignment = std::max(alignof(leaf), alignof(T));
+
+		// Key j, for 0 < j < count, is a copy of the first element under child j, so it names
+		// an element still in the tree. Only the root is ever empty.
+		struct inner : node {
+			std::array<node*, fanout> children = {};
+			std::array<std::size_t, fanout> counts = {};
+			alignas(T) std::byte keys[fanout * sizeof(T)];
+
+			auto key_ptr(std::uint32_t j) noexcept -> T* {
+				return reinterpret_cast<T*>(keys) + j;
+			}
+
+			auto key_ptr(std::uint32_t j) const noexcept -> T const* {
+				return reinterpret_cast<T const*>(keys) + j;
+			}
+
+			auto key(std::uint32_t j) noexcept -> T& {
+				return *key_ptr(j);
+			}
+
+			auto key(std::uint32_t j) const noexcept -> T const& {
+				return *key_ptr(j);
+			}
+		};
+
+		node* root_ = nullptr;
+		std::size_t size_ = 0;
+		// Inner levels above the leaves.
+		std::uint32_t height_ = 0;
+		node_arena arena_;
+
+		static auto as_leaf(node* n) noexcept -> leaf* {
+			return static_cast<leaf*>(n);
+		}
+
+		static auto as_leaf(node const* n) noexcept -> leaf const* {
+			return static_cast<leaf const*>(n);
+		}
+
+		static auto as_inner(node* n) noexcept -> inner* {
+			return static_cast<inner*>(n);
+		}
+
+		static auto as_inner(node const* n) noexcept -> inner const* {
+			return static_cast<inner const*>(n);
+		}
+
+		[[nodiscard]] static constexpr auto leaf_bytes(std::uint32_t capacity) noexcept
+		   -> std::size_t {
+			return items_offset + capacity * sizeof(T);
+		}
+
+		auto make_leaf(std::uint32_t capacity) -> leaf* {
+			return ::new (arena_.allocate(leaf_bytes(capacity), leaf_alignment)) leaf(capacity);
+		}
+
+		// Destroys the leaf's first live elements, as the rest have been moved out.
+		auto free_leaf(leaf* l, std::uint32_t live) noexcept -> void {
+			auto const bytes = leaf_bytes(l->capacity);
+			std::destroy_n(l->items(), live);
+			l->~leaf();
+			arena_.deallocate(l, bytes, leaf_alignment);
+		}
+
+		auto make_inner() -> inner* {
+			return ::new (arena_.allocate(sizeof(inner), alignof(inner))) inner;
+		}
+
+		// Destroys the node's keys without letting go of its children, which have been moved out.
+		auto free_inner(inner* in) noexcept -> void {
+			for (auto j = std::uint32_t{1}; j < in->count; ++j) {
+				std::destroy_at(in->key_ptr(j));
+			}
+			in->~inner();
+			arena_.deallocate(in, sizeof(inner), alignof(inner));
+		}
+
+		auto release(node* n, std::uint32_t h) noexcept -> void {
+			if (n == nullptr or n->refs.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+				return;
+			}
+			if (h == 0) {
+				free_leaf(as_leaf(n), n->count);
+				return;
+			}
+			auto* const in = as_inner(n);
+			for (auto j = std::uint32_t{0}; j < in->count; ++j) {
+				release(in->children[j], h - 1);
+			}
+			free_inner(in);
+		}
+
+		auto copy_leaf(leaf const* l, std::uint32_t capacity) -> leaf* {
+			auto* const copy = make_leaf(capacity);
+			try {
+				std::uninitialized_copy_n(l->items(), l->count, copy->items());
+			} catch (...) {
+				free_leaf(copy, 0);
+				throw;
+			}
+			copy->count = l->count;
+			return copy;
+		}
+
+		auto copy_inner(inner const* in) -> inner* {
+			auto* const copy = make_inner();
+			try {
+				std::uninitialized_copy(in->key_ptr(1), in->key_ptr(in->count), copy->key_ptr(1));
+			} catch (...) {
+				free_inner(copy);
+				throw;
+			}
+			copy->children = in->children;
+			copy->counts = in->counts;
+			copy->count = in->count;
+			for (auto j = std::uint32_t{0}; j < copy->count; ++j) {
+				copy->children[j]->refs.fetch_add(1, std::memory_order_relaxed);
+			}
+			return copy;
+		}
+
+		// Makes slot point at a node of this tree's own at height h.
+		auto own(node*& slot, std::uint32_t h) -> void {
+			if (slot->refs.load(std::memory_order_acquire) == 1) {
+				return;
+			}
+			node* const copy = h == 0 ? static_cast<node*>(copy_leaf(as_leaf(slot),
+			                                                         as_leaf(slot)->capacity))
+			                          : copy_inner(as_inner(slot));
+			release(std::exchange(slot, copy), h);
+		}
+
+		[[nodiscard]] static auto full(node const* n, std::uint32_t h) noexcept -> bool {
+			return h == 0 ? n->count == as_leaf(n)->capacity : n->count == fanout;
+		}
+
+		// Makes the root this tree's own with room for one more element or child: a small root
+		// leaf grows, and a full root gets a new root above it.
+		auto reserve_root() -> void {
+			if (root_ == nullptr) {
+				root_ = make_leaf(first_capacity);
+				return;
+			}
+			if (height_ == 0 and full(root_, 0) and as_leaf(root_)->capacity < leaf_capacity) {
+				auto* const l = as_leaf(root_);
+				auto const capacity = std::min(2 * l->capacity, leaf_capacity);
+				if (l->refs.load(std::memory_order_acquire) != 1) {
+					release(std::exchange(root_, copy_leaf(l, capacity)), 0);
+					return;
+				}
+				auto* const bigger = make_leaf(capacity);
+				std::uninitialized_move_n(l->items(), l->count, bigger->items());
+				bigger->count = l->count;
+				free_leaf(l, l->count);
+				root_ = bigger;
+				return;
+			}
+			own(root_, height_);
+			if (full(root_, height_)) {
+				assert(height_ + 1 < max_height);
+				auto* const up = make_inner();
+				up->children[0] = root_;
+				up->counts[0] = size_;
+				up->count = 1;
+				root_ = up;
+				++height_;
+			}
+		}
+
+		// Moves the keys from j on up by one and puts k at j.
+		static auto insert_key(inner* in, std::uint32_t j, T&& k) noexcept -> void {
+			auto const last = in->count;
+			if (j == last) {
+				std::construct_at(in->key_ptr(j), std::move(k));
+				return;
+			}
+			std::construct_at(in->key_ptr(last), std::move(in->key(last - 1)));
+			std::move_backward(in->key_ptr(j), in->key_ptr(last - 1), in->key_ptr(last));
+			in->key(j) = std::move(k);
+		}
+
+		// Takes key j out, moving the keys above it down by one.
+		static auto erase_key(inner* in, std::uint32_t j) noexcept -> void {
+			std::move(in->key_ptr(j + 1), in->key_ptr(in->count), in->key_ptr(j));
+			std::destroy_at(in->key_ptr(in->count - 1));
+		}
+
+		// Puts child at j with the key k in front of it, j > 0.
+		static auto insert_child(inner* in, std::uint32_t j, node* child, std::size_t count, T&& k)
+		   noexcept -> void {
+			insert_key(in, j, std::move(k));
+			auto* const children = in->children.data();
+			auto* const counts = in->counts.data();
+			std::move_backward(children + j, children + in->count, children + in->count + 1);
+			std::move_backward(counts + j, counts + in->count, counts + in->count + 1);
+			in->children[j] = child;
+			in->counts[j] = count;
+			++in->count;
+		}
+
+		// Takes child j and the key in front of it out, j > 0.
+		static auto erase_child(inner* in, std::uint32_t j) noexcept -> void {
+			erase_key(in, j);
+			std::move(&in->children[j + 1], &in->children[in->count], &in->children[j]);
+			std::move(&in->counts[j + 1], &in->counts[in->count], &in->counts[j]);
+			--in->count;
+		}
+
+		static auto insert_item(leaf* l, std::uint32_t i, T&& value) noexcept -> void {
+			auto* const items = l->items();
+			if (i == l->count) {
+				std::construct_at(items + i, std::move(value));
+			}
+			else {
+				std::construct_at(items + l->count, std::move(items[l->count - 1]));
+				std::move_backward(items + i, items + l->count - 1, items + l->count);
+				items[i] = std::move(value);
+			}
+			++l->count;
+		}
+
+		static auto erase_item(leaf* l, std::uint32_t i) noexcept -> void {
+			auto* const items = l->items();
+			std::move(items + i + 1, items + l->count, items + i);
+			std::destroy_at(items + l->count - 1);
+			--l->count;
+		}
+
+		// Splits the full child j of in, which has room for one more. An insertion at rank i of
+		// the child's end, as when appending, moves only the last element or child across, so
+		// that a tree built in order has full nodes.
+		auto split(inner* in, std::uint32_t j, std::size_t i, std::uint32_t h) -> void {
+			auto* const child = in->children[j];
+			auto const appending = i == in->counts[j];
+			if (h == 0) {
+				auto* const left = as_leaf(child);
+				auto const mid = appending ? left->count - 1 : left->count / 2;
+				auto k = T(left->items()[mid]);
+				auto* const right = make_leaf(leaf_capacity);
+				auto const moved = left->count - mid;
+				std::uninitialized_move_n(left->items() + mid, moved, right->items());
+				std::destroy_n(left->items() + mid, moved);
+				left->count = mid;
+				right->count = moved;
+				insert_child(in, j + 1, right, moved, std::move(k));
+				in->counts[j] -= moved;
+				return;
+			}
+			auto* const left = as_inner(child);
+			auto const mid = appending ? left->count - 1 : left->count / 2;
+			auto* const right = make_inner();
+			auto moved_items = std::size_t{0};
+			for (auto c = mid; c < left->count; ++c) {
+				right->children[c - mid] = left->children[c];
+				right->counts[c - mid] = left->counts[c];
+				moved_items += left->counts[c];
+			}
+			std::uninitialized_move(left->key_ptr(mid + 1),
+			                        left->key_ptr(left->count),
+			                        right->key_ptr(1));
+			right->count = left->count - mid;
+			auto k = T(std::move(left->key(mid)));
+			std::destroy(left->key_ptr(mid), left->key_ptr(left->count));
+			left->count = mid;
+			insert_child(in, j + 1, right, moved_items, std::move(k));
+			in->counts[j] -= moved_items;
+		}
+
+		// Makes the path to rank i this tree's own, noting each inner node and the child taken,
+		// and returns the leaf, with i turned into the rank within it.
+		auto own_path(std::size_t& i,
+		              std::array<inner*, max_height>& path,
+		              std::array<std::uint32_t, max_height>& slots) -> leaf* {
+			own(root_, height_);
+			auto** slot = &root_;
+			for (auto h = height_; h > 0; --h) {
+				auto* const in = as_inner(*slot);
+				auto j = std::uint32_t{0};
+				while (i >= in->counts[j]) {
+					i -= in->counts[j];
+					++j;
+				}
+				own(in->children[j], h - 1);
+				path[height_ - h] = in;
+				slots[height_ - h] = j;
+				slot = &in->children[j];
+			}
+			return as_leaf(*slot);
+		}
+
+		// Fewer elements or children than this and a node is merged with or filled from a
+		// sibling.
+		[[nodiscard]] static auto underfull(node const* n, std::uint32_t h) noexcept -> bool {
+			return n->count < (h == 0 ? leaf_capacity : fanout) / 4;
+		}
+
+		// Takes out the leaf at the end of the path, whose one element is being erased, along
+		// with every inner node above it left with no children. Where the node taken out was
+		// the first child, the key behind it becomes the key for the subtree, at key_node.
+		auto erase_leaf(std::array<inner*, max_height> const& path,
+		                std::array<std::uint32_t, max_height> const& slots,
+		                inner* key_node,
+		                std::uint32_t key_slot) noexcept -> void {
+			auto d = height_;
+			while (d > 0 and path[d - 1]->count == 1) {
+				--d;
+			}
+			if (d == 0) {
+				clear();
+				return;
+			}
+			auto* const in = path[d - 1];
+			auto const j = slots[d - 1];
+			release(in->children[j], height_ - d);
+			if (j > 0) {
+				erase_child(in, j);
+			}
+			else {
+				if (key_node != nullptr) {
+					key_node->key(key_slot) = std::move(in->key(1));
+				}
+				erase_key(in, 1);
+				std::move(&in->children[1], &in->children[in->count], &in->children[0]);
+				std::move(&in->counts[1], &in->counts[in->count], &in->counts[0]);
+				--in->count;
+			}
+			for (auto e = std::uint32_t{0}; e + 1 < d; ++e) {
+				--path[e]->counts[slots[e]];
+			}
+			--size_;
+			rebalance(path, slots, d - 1);
+		}
+
+		// Walks back up the path from an erasure, fixing underfull nodes from the child of
+		// path[from - 1] up, then shrinks the root.
+		auto rebalance(std::array<inner*, max_height> const& path,
+		               std::array<std::uint32_t, max_height> const& slots,
+		               std::uint32_t from) noexcept -> void {
+			for (auto d = from; d > 0; --d) {
+				auto* const parent = path[d - 1];
+				auto const h = height_ - d;
+				if (not underfull(parent->children[slots[d - 1]], h) or parent->count < 2) {
+					break;
+				}
+				auto const left = slots[d - 1] > 0 ? slots[d - 1] - 1 : 0;
+				try {
+					own(parent->children[left], h);
+					own(parent->children[left + 1], h);
+				} catch (...) {
+					break;
+				}
+				if (not(h == 0 ? fix_leaves(parent, left) : fix_inners(parent, left))) {
+					break;
+				}
+			}
+			while (height_ > 0 and root_->count == 1) {
+				auto* const old = as_inner(root_);
+				root_ = old->children[0];
+				free_inner(old);
+				--height_;
+			}
+			if (height_ == 0 and root_ != nullptr and root_->count == 0) {
+				release(std::exchange(root_, nullptr), 0);
+			}
+		}
+
+		// Merges children j and j + 1 of in if they fit in one leaf, or else evens them out, and
+		// returns whether in lost a child. Evening out copies the new key in front of child j + 1
+		// first, and is skipped if that throws.
+		auto fix_leaves(inner* in, std::uint32_t j) noexcept -> bool {
+			auto* const left = as_leaf(in->children[j]);
+			auto* const right = as_leaf(in->children[j + 1]);
+			auto* const l = left->items();
+			auto* const r = right->items();
+			if (left->count + right->count <= left->capacity) {
+				std::uninitialized_move_n(r, right->count, l + left->count);
+				left->count += right->count;
+				in->counts[j] += in->counts[j + 1];
+				free_leaf(right, right->count);
+				erase_child(in, j + 1);
+				return true;
+			}
+			auto const target = (left->count + right->count) / 2;
+			try {
+				if (left->count < target) {
+					auto const n = target - left->count;
+					auto k = T(r[n]);
+					std::uninitialized_move_n(r, n, l + left->count);
+					std::move(r + n, r + right->count, r);
+					std::destroy_n(r + right->count - n, n);
+					left->count += n;
+					right->count -= n;
+					in->key(j + 1) = std::move(k);
+					in->counts[j] += n;
+					in->counts[j + 1] -= n;
+				}
+				else if (left->count > target) {
+					auto const n = left->count - target;
+					auto const c = right->count;
+					auto k = T(l[target]);
+					if (n >= c) {
+						std::uninitialized_move_n(r, c, r + n);
+						std::destroy_n(r, c);
+					}
+					else {
+						std::uninitialized_move(r + c - n, r + c, r + c);
+						std::move_backward(r, r + c - n, r + c);
+						std::destroy_n(r, n);
+					}
+					std::uninitialized_move_n(l + target, n, r);
+					std::destroy_n(l + target, n);
+					left->count -= n;
+					right->count += n;
+					in->key(j + 1) = std::move(k);
+					in->counts[j] -= n;
+					in->counts[j + 1] += n;
+				}
+			} catch (...) {
+				// Both leaves are left as they were.
+			}
+			return false;
+		}
+
+		// The same for inner nodes, whose keys move through in, so nothing is copied.
+		auto fix_inners(inner* in, std::uint32_t j) noexcept -> bool {
+			auto* const left = as_inner(in->children[j]);
+			auto* const right = as_inner(in->children[j + 1]);
+			if (left->count + right->count <= fanout) {
+				auto const lc = left->count;
+				std::construct_at(left->key_ptr(lc), std::move(in->key(j + 1)));
+				std::uninitialized_move(right->key_ptr(1),
+				                        right->key_ptr(right->count),
+				                        left->key_ptr(lc + 1));
+				std::copy_n(right->children.begin(), right->count, left->children.begin() + lc);
+				std::copy_n(right->counts.begin(), right->count, left->counts.begin() + lc);
+				left->count += right->count;
+				in->counts[j] += in->counts[j + 1];
+				free_inner(right);
+				erase_child(in, j + 1);
+				return true;
+			}
+			auto const target = (left->count + right->count) / 2;
+			// Right's first child goes to the end of left.
+			while (left->count < target) {
+				auto const moved = right->counts[0];
+				std::construct_at(left->key_ptr(left->count), std::move(in->key(j + 1)));
+				left->children[left->count] = right->children[0];
+				left->counts[left->count] = moved;
+				++left->count;
+				in->key(j + 1) = std::move(right->key(1));
+				erase_key(right, 1);
+				std::move(right->children.begin() + 1,
+				          right->children.begin() + right->count,
+				          right->children.begin());
+				std::move(right->counts.begin() + 1,
+				          right->counts.begin() + right->count,
+				          right->counts.begin());
+				--right->count;
+				in->counts[j] += moved;
+				in->counts[j + 1] -= moved;
+			}
+			// Left's last child goes to the front of right.
+			while (left->count > target) {
+				auto const last = left->count - 1;
+				auto const moved = left->counts[last];
+				insert_key(right, 1, std::move(in->key(j + 1)));
+				std::move_backward(right->children.begin(),
+				                   right->children.begin() + right->count,
+				                   right->children.begin() + right->count + 1);
+				std::move_backward(right->counts.begin(),
+				                   right->counts.begin() + right->count,
+				                   right->counts.begin() + right->count + 1);
+				right->children[0] = left->children[last];
+				right->counts[0] = moved;
+				++right->count;
+				in->key(j + 1) = std::move(left->key(last));
+				std::destroy_at(left->key_ptr(last));
+				--left->count;
+				in->counts[j] -= moved;
+				in->counts[j + 1] += moved;
+			}
+			return false;
+		}
+
+	public:
+		class iterator {
+		public:
+			using value_type = T;
+			using reference = T const&;
+			using pointer = T const*;
+			using difference_type = std::ptrdiff_t;
+			using iterator_category = std::bidirectional_iterator_tag;
+
+			iterator() = default;
+
+			auto operator*() const -> T const& {
+				return leaf_->items()[slot_];
+			}
+
+			auto operator->() const -> T const* {
+				return leaf_->items() + slot_;
+			}
+
+			auto operator++() -> iterator& {
+				++rank_;
+				if (++slot_ == leaf_->count) {
+					*this = tree_->at(rank_);
+				}
+				return *this;
+			}
+
+			auto operator++(int) -> iterator {
+				auto old = *this;
+				++(*this);
+				return old;
+			}
+
+			auto operator--() -> iterator& {
+				--rank_;
+				if (slot_ == 0) {
+					*this = tree_->at(rank_);
+				}
+				else {
+					--slot_;
+				}
+				return *this;
+			}
+
+			auto operator--(int) -> iterator {
+				auto old = *this;
+				--(*this);
+				return old;
+			}
+
+			auto operator==(iterator const& other) const noexcept -> bool {
+				return rank_ == other.rank_ and tree_ == other.tree_;
+			}
+
+			// The element's rank.
+			[[nodiscard]] auto index() const noexcept -> std::size_t {
+				return rank_;
+			}
+
+		private:
+			friend class btree;
+
+			btree const* tree_ = nullptr;
+			leaf const* leaf_ = nullptr;
+			std::uint32_t slot_ = 0;
+			std::size_t rank_ = 0;
+
+			iterator(btree const* tree, leaf const* l, std::uint32_t slot, std::size_t rank)
+			: tree_{tree}
+			, leaf_{l}
+			, slot_{slot}
+			, rank_{rank} {}
+		};
+
+	private:
+		// The first element for which before() is false, before() being true of a prefix of the
+		// sequence. A key is no greater than anything after it, so the answer is under the child
+		// in front of the first key for which before() is false.
+		template<typename Before>
+		[[nodiscard]] auto search(Before before) const -> iterator {
+			if (root_ == nullptr) {
+				return end();
+			}
+			auto rank = std::size_t{0};
+			auto const* n = root_;
+			for (auto h = height_; h > 0; --h) {
+				auto const* in = as_inner(n);
+				auto lo = std::uint32_t{1};
+				auto hi = in->count;
+				while (lo < hi) {
+					auto const mid = lo + (hi - lo) / 2;
+					if (before(in->key(mid))) {
+						lo = mid + 1;
+					}
+					else {
+						hi = mid;
+					}
+				}
+				for (auto c = std::uint32_t{0}; c + 1 < lo; ++c) {
+					rank += in->counts[c];
+				}
+				n = in->children[lo - 1];
+			}
+			auto const* l = as_leaf(n);
+			auto const slot = static_cast<std::uint32_t>(
+			   std::partition_point(l->items(), l->items() + l->count, before) - l->items());
+			if (slot == l->count) {
+				return at(rank + slot);
+			}
+			return iterator{this, l, slot, rank + slot};
+		}
+	};
+} // namespace gdwg::detail
+
+#endif // GDWG_BTREE_HPP
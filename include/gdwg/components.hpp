@@ -0,0 +1,244 @@
+#ifndef GDWG_COMPONENTS_HPP
+#define GDWG_COMPONENTS_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <ranges>
+#include <vector>
+
+#include "gdwg/frozen_graph.hpp"
+#include "gdwg/graph.hpp"
+#include "gdwg/parallel.hpp"
+
+namespace gdwg {
+	namespace detail {
+		// How many of each node's successors weakly_connected_components() links before
+		// compressing the forest.
+		inline constexpr auto afforest_rounds = std::size_t{2};
+
+		// Union-find over node indices that any number of threads may link in at once, without
+		// locks. Each node points at a node of its set with a lower or equal index; a node that
+		// points at itself is the root, so every set's root is its least member.
+		template<typename Index>
+		class concurrent_forest {
+		public:
+			explicit concurrent_forest(std::vector<Index>& parent)
+			: parent_{parent} {}
+
+			// Joins the sets of u and v by pointing the higher root at the lower. Another thread
+			// may re-point that root first; then the roots are looked up again.
+			auto link(Index u, Index v) -> void {
+				auto p1 = load(u);
+				auto p2 = load(v);
+				while (p1 != p2) {
+					auto const high = std::max(p1, p2);
+					auto const low = std::min(p1, p2);
+					auto const p_high = load(high);
+					if (p_high == low) {
+						return;
+					}
+					auto expected = high;
+					if (p_high == high and ref(high).compare_exchange_strong(expected, low)) {
+						return;
+					}
+					p1 = load(load(high));
+					p2 = load(low);
+				}
+			}
+
+			// Points v straight at its root.
+			auto compress(Index v) -> void {
+				while (load(v) != load(load(v))) {
+					ref(v).store(load(load(v)), std::memory_order_relaxed);
+				}
+			}
+
+			[[nodiscard]] auto same_parent(Index u, Index v) const -> bool {
+				return load(u) == load(v);
+			}
+
+		private:
+			std::vector<Index>& parent_;
+
+			[[nodiscard]] auto ref(Index v) const -> std::atomic_ref<Index> {
+				return std::atomic_ref<Index>(parent_[v]);
+			}
+
+			[[nodiscard]] auto load(Index v) const -> Index {
+				return ref(v).load(std::memory_order_relaxed);
+			}
+		};
+	} // namespace detail
+
+	// The weakly connected component of every node of a snapshot, by node index: two nodes share
+	// a component if edges join them when their directions are ignored. A component is named by
+	// its least node index.
+	//
+	// Afforest (Sutton et al.), on the given number of threads. Linking each node to its first
+	// few successors and compressing the forest settles most of a power-law graph while touching
+	// few of its edges; the remaining edges are then linked, most of them found already joined
+	// with two loads. Afforest would skip the nodes of the largest component there, but with
+	// directed edges that needs every node's predecessors, so every edge is still looked at.
+	template<typename N, typename E>
+	[[nodiscard]] auto weakly_connected_components(frozen_graph<N, E> const& g,
+	                                               unsigned threads = detail::default_threads())
+	   -> std::vector<typename frozen_graph<N, E>::index_type> {
+		using index_type = typename frozen_graph<N, E>::index_type;
+		constexpr auto chunk = std::size_t{1024};
+
+		threads = std::max(1U, threads);
+		auto component = std::vector<index_type>(g.num_nodes());
+		auto forest = detail::concurrent_forest<index_type>(component);
+		auto const n = g.num_nodes();
+		detail::parallel_for(threads, n, chunk, [&component](std::size_t v) {
+			component[v] = static_cast<index_type>(v);
+		});
+		for (auto round = std::size_t{0}; round < detail::afforest_rounds; ++round) {
+			detail::parallel_for(threads, n, chunk, [&g, &forest, round](std::size_t u) {
+				auto const targets = g.targets(u);
+				if (round < targets.size()) {
+					forest.link(static_cast<index_type>(u), targets[round]);
+				}
+			});
+			detail::parallel_for(threads, n, chunk, [&forest](std::size_t v) {
+				forest.compress(static_cast<index_type>(v));
+			});
+		}
+		detail::parallel_for(threads, n, chunk / 16, [&g, &forest](std::size_t u) {
+			auto const targets = g.targets(u);
+			auto const first = std::min(detail::afforest_rounds, targets.size());
+			for (auto i = first; i < targets.size(); ++i) {
+				if (not forest.same_parent(static_cast<index_type>(u), targets[i])) {
+					forest.link(static_cast<index_type>(u), targets[i]);
+				}
+			}
+		});
+		detail::parallel_for(threads, n, chunk, [&forest](std::size_t v) {
+			forest.compress(static_cast<index_type>(v));
+		});
+		return component;
+	}
+
+	// What strongly_connected_components() finds.
+	template<typename E, typename Layout>
+	struct condensation {
+		// The component of a node the id doesn't belong to.
+		static constexpr auto no_component = std::numeric_limits<std::uint32_t>::max();
+
+		// The component of every node, by node id as returned by graph::id_of().
+		std::vector<std::uint32_t> component;
+		// A node for every component, numbered so that every edge goes from a lower number to a
+		// higher one. Each edge of the graph between two components is an edge of the same weight
+		// between their nodes.
+		graph<std::uint32_t, E, Layout> dag;
+	};
+
+	// The strongly connected components of g: two nodes share a component if each can reach the
+	// other. Tarjan's algorithm in O(n + e), looping over explicit stacks instead of recursing,
+	// so chains of any length fit. The edges are first copied by id into contiguous arrays, so
+	// the search itself only touches arrays allocated up front; building dag then costs
+	// O(e log e) more, as inserting edges into any graph does.
+	template<typename N, typename E, typename Layout>
+	[[nodiscard]] auto strongly_connected_components(graph<N, E, Layout> const& g)
+	   -> condensation<E, Layout> {
+		using node_id = typename graph<N, E, Layout>::node_id;
+		using result = condensation<E, Layout>;
+		constexpr auto unvisited = std::numeric_limits<std::uint32_t>::max();
+
+		// Each node's edges by id. The graph's own edges cost far more to follow than arrays, so
+		// they are walked once, for both the search and dag.
+		auto const n = g.id_bound();
+		auto offsets = std::vector<std::size_t>(n + 1, 0);
+		auto targets = std::vector<std::uint32_t>{};
+		auto weights = std::vector<E const*>{};
+		for (auto u = std::size_t{0}; u < n; ++u) {
+			if (g.is_node(static_cast<node_id>(u))) {
+				for (auto const& [dst, weight] : g.out_edges(static_cast<node_id>(u))) {
+					targets.push_back(static_cast<std::uint32_t>(dst));
+					weights.push_back(&weight);
+				}
+			}
+			offsets[u + 1] = targets.size();
+		}
+
+		// The order nodes are found in, and the least such order of a node on the stack that
+		// each can reach. A node found but not yet given a component is on the stack.
+		auto order = std::vector<std::uint32_t>(n, unvisited);
+		auto low = std::vector<std::uint32_t>(n);
+		auto component = std::vector<std::uint32_t>(n, result::no_component);
+		// Tarjan's stack, and the search's own: a node, and the next of its edges to follow.
+		auto stack = std::vector<std::uint32_t>(n);
+		auto stack_size = std::size_t{0};
+		auto path = std::vector<std::uint32_t>(n);
+		auto next_edge = std::vector<std::size_t>(n);
+		auto path_size = std::size_t{0};
+		auto found = std::uint32_t{0};
+		auto num_components = std::uint32_t{0};
+
+		auto const visit = [&](std::uint32_t v) {
+			order[v] = low[v] = found++;
+			stack[stack_size++] = v;
+			path[path_size] = v;
+			next_edge[path_size++] = offsets[v];
+		};
+		for (auto root = std::uint32_t{0}; root < n; ++root) {
+			if (order[root] != unvisited or not g.is_node(static_cast<node_id>(root))) {
+				continue;
+			}
+			visit(root);
+			while (path_size > 0) {
+				auto const u = path[path_size - 1];
+				auto& edge = next_edge[path_size - 1];
+				if (edge < offsets[u + 1]) {
+					auto const v = targets[edge++];
+					if (order[v] == unvisited) {
+						visit(v);
+					}
+					else if (component[v] == result::no_component) {
+						low[u] = std::min(low[u], order[v]);
+					}
+					continue;
+				}
+				--path_size;
+				if (low[u] == order[u]) {
+					auto v = std::uint32_t{0};
+					do {
+						v = stack[--stack_size];
+						component[v] = num_components;
+					} while (v != u);
+					++num_components;
+				}
+				if (path_size > 0) {
+					auto const parent = path[path_size - 1];
+					low[parent] = std::min(low[parent], low[u]);
+				}
+			}
+		}
+
+		// Components come out sinks first, so counting down from the last puts them in
+		// topological order.
+		for (auto& c : component) {
+			if (c != result::no_component) {
+				c = num_components - 1 - c;
+			}
+		}
+		auto const nodes = std::views::iota(std::uint32_t{0}, num_components);
+		auto dag = graph<std::uint32_t, E, Layout>(nodes.begin(), nodes.end());
+		auto edges = std::vector<typename graph<std::uint32_t, E, Layout>::value_type>{};
+		for (auto u = std::size_t{0}; u < n; ++u) {
+			for (auto i = offsets[u]; i < offsets[u + 1]; ++i) {
+				auto const to = component[targets[i]];
+				if (to != component[u]) {
+					edges.push_back({component[u], to, *weights[i]});
+				}
+			}
+		}
+		dag.insert_edges(edges.begin(), edges.end());
+		return result{std::move(component), std::move(dag)};
+	}
+} // namespace gdwg
+
+#endif // GDWG_COMPONENTS_HPP
@@ -0,0 +1,294 @@
+#ifndef GDWG_CSR_VIEW_HPP
+#define GDWG_CSR_VIEW_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gdwg/text_sink.hpp"
+
+namespace gdwg::detail {
+	// The queries of frozen_graph and mapped_graph, which differ only in where their compressed
+	// sparse row arrays live. Nodes are numbered 0 to num_nodes() - 1 in sorted order. The edges
+	// leaving node i are positions offsets[i] to offsets[i + 1] of targets and weights, sorted by
+	// (destination, weight) exactly as graph sorts them. A view doesn't own the arrays; name is
+	// the type that does, for error messages.
+	template<typename N, typename E, typename Offset>
+	class csr_view {
+	public:
+		struct value_type {
+			N from;
+			N to;
+			E weight;
+		};
+
+		// As graph::reference: the edge's members by reference into the arrays.
+		struct reference {
+			N const& from;
+			N const& to;
+			E const& weight;
+
+			operator value_type() const { // NOLINT(google-explicit-constructor)
+				return value_type{from, to, weight};
+			}
+		};
+
+		using index_type = std::uint32_t;
+
+		class iterator;
+
+		csr_view() = default;
+
+		csr_view(char const* name,
+		         std::span<N const> nodes,
+		         std::span<Offset const> offsets,
+		         std::span<index_type const> targets,
+		         std::span<E const> weights)
+		: name_{name}
+		, nodes_{nodes}
+		, offsets_{offsets}
+		, targets_{targets}
+		, weights_{weights} {}
+
+		// Accessors
+		[[nodiscard]] auto is_node(N const& value) const -> bool {
+			return find_index(value) != num_nodes();
+		}
+
+		[[nodiscard]] auto empty() const -> bool {
+			return nodes_.empty();
+		}
+
+		// log(n) + log(out-degree)
+		[[nodiscard]] auto is_connected(N const& src, N const& dst) const -> bool {
+			auto const s = find_index(src);
+			auto const d = find_index(dst);
+			if (s != num_nodes() and d != num_nodes()) {
+				auto const t = targets(s);
+				return std::binary_search(t.begin(), t.end(), d);
+			}
+			throw error("is_connected if src or dst node don't exist in the graph");
+		}
+
+		[[nodiscard]] auto nodes() const -> std::vector<N> {
+			return std::vector<N>(nodes_.begin(), nodes_.end());
+		}
+
+		// log(n) + log(out-degree)
+		[[nodiscard]] auto weights(N const& src, N const& dst) const -> std::vector<E> {
+			auto const s = find_index(src);
+			auto const d = find_index(dst);
+			if (s != num_nodes() and d != num_nodes()) {
+				auto const [first, last] = edge_range(s, d);
+				return std::vector<E>(weights_.begin() + static_cast<std::ptrdiff_t>(first),
+				                      weights_.begin() + static_cast<std::ptrdiff_t>(last));
+			}
+			throw error("weights if src or dst node don't exist in the graph");
+		}
+
+		// log(n) + log(out-degree)
+		[[nodiscard]] auto find(N const& src, N const& dst, E const& weight) const -> iterator {
+			auto const s = find_index(src);
+			auto const d = find_index(dst);
+			if (s == num_nodes() or d == num_nodes()) {
+				return end();
+			}
+			auto const [first, last] = edge_range(s, d);
+			auto const w = std::lower_bound(weights_.begin() + static_cast<std::ptrdiff_t>(first),
+			                                weights_.begin() + static_cast<std::ptrdiff_t>(last),
+			                                weight);
+			auto const pos = static_cast<std::size_t>(w - weights_.begin());
+			if (pos == last or weight < *w) {
+				return end();
+			}
+			return iterator{*this, s, pos};
+		}
+
+		// log(n) + out-degree
+		[[nodiscard]] auto connections(N const& src) const -> std::vector<N> {
+			auto const s = find_index(src);
+			if (s != num_nodes()) {
+				auto v = std::vector<N>{};
+				v.reserve(targets(s).size());
+				for (auto const d : targets(s)) {
+					v.push_back(nodes_[d]);
+				}
+				return v;
+			}
+			throw error("connections if src doesn't exist in the graph");
+		}
+
+		// Index-based access for traversals, which should work with these rather than with N.
+		[[nodiscard]] auto num_nodes() const noexcept -> std::size_t {
+			return nodes_.size();
+		}
+
+		[[nodiscard]] auto num_edges() const noexcept -> std::size_t {
+			return targets_.size();
+		}
+
+		// Returns num_nodes() if value isn't a node.
+		[[nodiscard]] auto find_index(N const& value) const -> std::size_t {
+			auto const it = std::lower_bound(nodes_.begin(), nodes_.end(), value);
+			if (it == nodes_.end() or value < *it) {
+				return num_nodes();
+			}
+			return static_cast<std::size_t>(it - nodes_.begin());
+		}
+
+		[[nodiscard]] auto node(std::size_t i) const -> N const& {
+			return nodes_[i];
+		}
+
+		[[nodiscard]] auto offsets() const noexcept -> std::span<Offset const> {
+			return offsets_;
+		}
+
+		[[nodiscard]] auto targets(std::size_t i) const -> std::span<index_type const> {
+			return targets_.subspan(offsets_[i], out_degree(i));
+		}
+
+		// Every node's targets, one row after another.
+		[[nodiscard]] auto all_targets() const noexcept -> std::span<index_type const> {
+			return targets_;
+		}
+
+		[[nodiscard]] auto edge_weights(std::size_t i) const -> std::span<E const> {
+			return weights_.subspan(offsets_[i], out_degree(i));
+		}
+
+		[[nodiscard]] auto out_degree(std::size_t i) const -> std::size_t {
+			return offsets_[i + 1] - offsets_[i];
+		}
+
+		// Iterator
+		[[nodiscard]] auto begin() const -> iterator {
+			return iterator{*this, first_source(0), 0};
+		}
+
+		[[nodiscard]] auto end() const -> iterator {
+			return iterator{*this, num_nodes(), num_edges()};
+		}
+
+	private:
+		char const* name_ = "";
+		std::span<N const> nodes_;
+		std::span<Offset const> offsets_;
+		std::span<index_type const> targets_;
+		std::span<E const> weights_;
+
+		[[nodiscard]] auto error(char const* what) const -> std::runtime_error {
+			return std::runtime_error(std::string("Cannot call ") + name_ + "::" + what);
+		}
+
+		// Positions of the edges from s to d.
+		[[nodiscard]] auto edge_range(std::size_t s, std::size_t d) const
+		   -> std::pair<std::size_t, std::size_t> {
+			auto const t = targets(s);
+			auto const [first, last] = std::ranges::equal_range(t, static_cast<index_type>(d));
+			return {offsets_[s] + static_cast<std::size_t>(first - t.begin()),
+			        offsets_[s] + static_cast<std::size_t>(last - t.begin())};
+		}
+
+		// The first node from i on that has an out-edge, or num_nodes().
+		[[nodiscard]] auto first_source(std::size_t i) const -> std::size_t {
+			while (i < num_nodes() and out_degree(i) == 0) {
+				++i;
+			}
+			return i;
+		}
+
+		// Hidden Friend: Extractor
+		friend auto operator<<(std::ostream& os, csr_view const& g) -> std::ostream& {
+			auto out = text_sink(os);
+			for (auto i = std::size_t{0}; i < g.num_nodes(); ++i) {
+				out.put(g.nodes_[i]);
+				out.put(" (\n");
+				for (auto pos = g.offsets_[i]; pos < g.offsets_[i + 1]; ++pos) {
+					out.put("  ");
+					out.put(g.nodes_[g.targets_[pos]]);
+					out.put(" | ");
+					out.put(g.weights_[pos]);
+					out.put("\n");
+				}
+				out.put(")\n");
+			}
+			out.flush();
+			return os;
+		}
+
+	public:
+		// Holds a copy of the view, so it stays valid for as long as the arrays do.
+		class iterator {
+		public:
+			using value_type = csr_view::value_type;
+			using reference = csr_view::reference;
+			using pointer = void;
+			using difference_type = std::ptrdiff_t;
+			using iterator_category = std::bidirectional_iterator_tag;
+
+			// Iterator constructor
+			iterator() = default;
+
+			// Iterator source
+			auto operator*() const -> reference {
+				return reference{g_.nodes_[src_], g_.nodes_[g_.targets_[pos_]], g_.weights_[pos_]};
+			}
+
+			// Iterator traversal
+			auto operator++() -> iterator& {
+				++pos_;
+				while (src_ < g_.num_nodes() and g_.offsets_[src_ + 1] <= pos_) {
+					++src_;
+				}
+				return *this;
+			}
+
+			auto operator++(int) -> iterator {
+				auto old = *this;
+				++(*this);
+				return old;
+			}
+
+			auto operator--() -> iterator& {
+				--pos_;
+				while (g_.offsets_[src_] > pos_) {
+					--src_;
+				}
+				return *this;
+			}
+
+			auto operator--(int) -> iterator {
+				auto old = *this;
+				--(*this);
+				return old;
+			}
+
+			// Iterator comparison
+			auto operator==(iterator const& other) const -> bool {
+				return g_.nodes_.data() == other.g_.nodes_.data() and pos_ == other.pos_;
+			}
+
+		private:
+			friend class csr_view;
+
+			csr_view g_;
+			std::size_t src_ = 0;
+			std::size_t pos_ = 0;
+
+			iterator(csr_view const& g, std::size_t src, std::size_t pos)
+			: g_{g}
+			, src_{src}
+			, pos_{pos} {}
+		};
+	};
+} // namespace gdwg::detail
+
+#endif // GDWG_CSR_VIEW_HPP
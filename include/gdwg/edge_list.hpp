@@ -0,0 +1,134 @@
+#ifndef GDWG_EDGE_LIST_HPP
+#define GDWG_EDGE_LIST_HPP
+
+#include <charconv>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstring>
+#include <ios>
+#include <istream>
+#include <string>
+#include <system_error>
+
+#include "gdwg/text_sink.hpp"
+
+namespace gdwg::detail {
+	// Types an edge list field is parsed into.
+	template<typename T>
+	concept number_field = plain_integer<T> or std::floating_point<T>;
+
+	// Reads "src dst [weight]" lines from a stream in large chunks and parses them with
+	// std::from_chars, which doesn't look at the locale or build a sentry per value. Fields are
+	// separated by spaces, tabs or commas; fields after the weight are ignored. Blank lines and
+	// lines starting with '#' or '%' (the SNAP and KONECT comment markers) are skipped. A NaN
+	// field is malformed, since graphs order their nodes and weights.
+	template<number_field N, number_field E>
+	class edge_list_reader {
+	public:
+		enum class result { edge, end, malformed };
+
+		edge_list_reader(std::istream& is, E const& default_weight)
+		: is_{is}
+		, default_weight_{default_weight} {
+			buffer_.resize(chunk_size);
+		}
+
+		// Parses the next edge into from, to and weight.
+		auto next(N& from, N& to, E& weight) -> result {
+			for (;;) {
+				auto const* line = buffer_.data() + begin_;
+				auto const* const filled = buffer_.data() + end_;
+				auto const* newline = static_cast<char const*>(
+				   std::memchr(line, '\n', static_cast<std::size_t>(filled - line)));
+				if (newline == nullptr and not eof_) {
+					refill();
+					continue;
+				}
+				auto const* const line_end = newline == nullptr ? filled : newline;
+				begin_ = newline == nullptr ? end_
+				                            : static_cast<std::size_t>(newline + 1 - buffer_.data());
+				++line_;
+
+				auto const* p = skip_separators(line, line_end);
+				if (p == line_end or *p == '#' or *p == '%') {
+					if (newline == nullptr) {
+						return result::end;
+					}
+					continue;
+				}
+				if (not parse(p, line_end, from) or not parse(p, line_end, to)) {
+					return result::malformed;
+				}
+				if (p == line_end) {
+					weight = default_weight_;
+					return result::edge;
+				}
+				return parse(p, line_end, weight) ? result::edge : result::malformed;
+			}
+		}
+
+		// The number of the line next() last looked at, counting from 1.
+		[[nodiscard]] auto line() const noexcept -> std::size_t {
+			return line_;
+		}
+
+	private:
+		static constexpr auto chunk_size = std::size_t{1} << 20;
+
+		std::istream& is_;
+		E default_weight_;
+		std::string buffer_;
+		// The unparsed input is buffer_[begin_, end_).
+		std::size_t begin_ = 0;
+		std::size_t end_ = 0;
+		std::size_t line_ = 0;
+		bool eof_ = false;
+
+		static auto skip_separators(char const* p, char const* last) -> char const* {
+			while (p != last and (*p == ' ' or *p == '\t' or *p == ',' or *p == '\r')) {
+				++p;
+			}
+			return p;
+		}
+
+		// Parses one field starting at p and moves p to the next field.
+		template<typename T>
+		static auto parse(char const*& p, char const* last, T& value) -> bool {
+			auto const [ptr, ec] = std::from_chars(p, last, value);
+			if (ec != std::errc{} or (ptr != last and skip_separators(ptr, last) == ptr)) {
+				return false;
+			}
+			if constexpr (std::floating_point<T>) {
+				if (std::isnan(value)) {
+					return false;
+				}
+			}
+			p = skip_separators(ptr, last);
+			return true;
+		}
+
+		// Moves the partial line to the front and reads the next chunk after it, growing the
+		// buffer if one line doesn't fit.
+		auto refill() -> void {
+			auto const partial = end_ - begin_;
+			std::memmove(buffer_.data(), buffer_.data() + begin_, partial);
+			begin_ = 0;
+			end_ = partial;
+			if (buffer_.size() - end_ < chunk_size / 2) {
+				buffer_.resize(buffer_.size() * 2);
+			}
+			auto* const stream = is_.rdbuf();
+			auto const wanted = static_cast<std::streamsize>(buffer_.size() - end_);
+			auto const got =
+			   is_ and stream != nullptr ? stream->sgetn(buffer_.data() + end_, wanted) : 0;
+			end_ += static_cast<std::size_t>(got);
+			if (got < wanted) {
+				eof_ = true;
+				is_.setstate(std::ios_base::eofbit);
+			}
+		}
+	};
+} // namespace gdwg::detail
+
+#endif // GDWG_EDGE_LIST_HPP
@@ -0,0 +1,174 @@
+#ifndef GDWG_FROZEN_GRAPH_HPP
+#define GDWG_FROZEN_GRAPH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <numeric>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "gdwg/csr_view.hpp"
+#include "gdwg/layout.hpp"
+
+namespace gdwg {
+	// Read-only snapshot of a graph in compressed sparse row form, made by graph::freeze(). The
+	// queries are csr_view's, over arrays the snapshot owns.
+	template<typename N, typename E>
+	class frozen_graph {
+		using view_type = detail::csr_view<N, E, std::size_t>;
+
+	public:
+		using value_type = typename view_type::value_type;
+		using reference = typename view_type::reference;
+		using index_type = typename view_type::index_type;
+		using iterator = typename view_type::iterator;
+
+		frozen_graph() = default;
+
+		// Accessors
+		[[nodiscard]] auto is_node(N const& value) const -> bool {
+			return view().is_node(value);
+		}
+
+		[[nodiscard]] auto empty() const -> bool {
+			return nodes_.empty();
+		}
+
+		// log(n) + log(out-degree)
+		[[nodiscard]] auto is_connected(N const& src, N const& dst) const -> bool {
+			return view().is_connected(src, dst);
+		}
+
+		[[nodiscard]] auto nodes() const -> std::vector<N> {
+			return nodes_;
+		}
+
+		// log(n) + log(out-degree)
+		[[nodiscard]] auto weights(N const& src, N const& dst) const -> std::vector<E> {
+			return view().weights(src, dst);
+		}
+
+		// log(n) + log(out-degree)
+		[[nodiscard]] auto find(N const& src, N const& dst, E const& weight) const -> iterator {
+			return view().find(src, dst, weight);
+		}
+
+		// log(n) + out-degree
+		[[nodiscard]] auto connections(N const& src) const -> std::vector<N> {
+			return view().connections(src);
+		}
+
+		// Index-based access for traversals, which should work with these rather than with N.
+		[[nodiscard]] auto num_nodes() const noexcept -> std::size_t {
+			return nodes_.size();
+		}
+
+		[[nodiscard]] auto num_edges() const noexcept -> std::size_t {
+			return targets_.size();
+		}
+
+		// Returns num_nodes() if value isn't a node.
+		[[nodiscard]] auto find_index(N const& value) const -> std::size_t {
+			return view().find_index(value);
+		}
+
+		[[nodiscard]] auto node(std::size_t i) const -> N const& {
+			return nodes_[i];
+		}
+
+		[[nodiscard]] auto offsets() const noexcept -> std::span<std::size_t const> {
+			return offsets_;
+		}
+
+		[[nodiscard]] auto targets(std::size_t i) const -> std::span<index_type const> {
+			return view().targets(i);
+		}
+
+		[[nodiscard]] auto edge_weights(std::size_t i) const -> std::span<E const> {
+			return view().edge_weights(i);
+		}
+
+		[[nodiscard]] auto out_degree(std::size_t i) const -> std::size_t {
+			return offsets_[i + 1] - offsets_[i];
+		}
+
+		// Iterator
+		[[nodiscard]] auto begin() const -> iterator {
+			return view().begin();
+		}
+
+		[[nodiscard]] auto end() const -> iterator {
+			return view().end();
+		}
+
+		// Comparison
+		[[nodiscard]] auto operator==(frozen_graph const& other) const -> bool = default;
+
+	private:
+		template<typename, typename, typename>
+		friend class graph;
+
+		std::vector<N> nodes_;
+		std::vector<std::size_t> offsets_ = std::vector<std::size_t>(1, 0);
+		std::vector<index_type> targets_;
+		std::vector<E> weights_;
+
+		frozen_graph(std::vector<N> nodes,
+		             std::vector<std::size_t> offsets,
+		             std::vector<index_type> targets,
+		             std::vector<E> weights)
+		: nodes_{std::move(nodes)}
+		, offsets_{std::move(offsets)}
+		, targets_{std::move(targets)}
+		, weights_{std::move(weights)} {}
+
+		[[nodiscard]] auto view() const noexcept -> view_type {
+			return view_type("gdwg::frozen_graph<N, E>", nodes_, offsets_, targets_, weights_);
+		}
+
+		// Hidden Friend: Extractor
+		friend auto operator<<(std::ostream& os, frozen_graph const& g) -> std::ostream& {
+			return os << g.view();
+		}
+	};
+
+	namespace detail {
+		// A snapshot's edges grouped by destination: the sources of the edges into node v, in
+		// increasing order, for algorithms that pull from a node's predecessors.
+		template<typename Index>
+		struct reverse_rows {
+			std::vector<std::size_t> offsets;
+			std::vector<Index> sources;
+
+			[[nodiscard]] auto sources_of(std::size_t v) const -> std::span<Index const> {
+				return std::span<Index const>(sources).subspan(offsets[v], offsets[v + 1] - offsets[v]);
+			}
+		};
+
+		// O(n + e), as a counting sort of the edges by destination.
+		template<typename N, typename E>
+		auto reverse(frozen_graph<N, E> const& g)
+		   -> reverse_rows<typename frozen_graph<N, E>::index_type> {
+			using index_type = typename frozen_graph<N, E>::index_type;
+			auto rows = reverse_rows<index_type>{std::vector<std::size_t>(g.num_nodes() + 1, 0),
+			                                     std::vector<index_type>(g.num_edges())};
+			for (auto u = std::size_t{0}; u < g.num_nodes(); ++u) {
+				for (auto const v : g.targets(u)) {
+					++rows.offsets[v + 1];
+				}
+			}
+			std::partial_sum(rows.offsets.begin(), rows.offsets.end(), rows.offsets.begin());
+			auto fill = std::vector<std::size_t>(rows.offsets.begin(), rows.offsets.end() - 1);
+			for (auto u = std::size_t{0}; u < g.num_nodes(); ++u) {
+				for (auto const v : g.targets(u)) {
+					rows.sources[fill[v]++] = static_cast<index_type>(u);
+				}
+			}
+			return rows;
+		}
+	} // namespace detail
+} // namespace gdwg
+
+#endif // GDWG_FROZEN_GRAPH_HPP
@@ -2,19 +2,57 @@
 #define GDWG_GRAPH_HPP
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <cstddef>
+#include <cstdint>
 #include <initializer_list>
 #include <iostream>
 #include <iterator>
+#include <limits>
 #include <memory>
-#include <set>
+#include <numeric>
+#include <optional>
+#include <ranges>
 #include <sstream>
+#include <stdexcept>
+#include <string>
 #include <tuple>
+#include <type_traits>
 #include <utility>
+#include <variant>
 #include <vector>
 
+#include "gdwg/btree.hpp"
+#include "gdwg/edge_list.hpp"
+#include "gdwg/frozen_graph.hpp"
+#include "gdwg/hash.hpp"
+#include "gdwg/intern.hpp"
+#include "gdwg/layout.hpp"
+#include "gdwg/radix_table.hpp"
+#include "gdwg/serialize.hpp"
+#include "gdwg/small_tree.hpp"
+#include "gdwg/text_sink.hpp"
+
 namespace gdwg {
-	template<typename N, typename E>
+	// Copies are O(1): they share nodes and edges with the original, kept in trees of
+	// reference-counted chunks. A modifier called on a shared graph copies only the chunks on its
+	// paths that another graph still holds, O(log n) of them, so the other copies never see the
+	// change. Distinct graph objects may be used from different threads even while they share
+	// state, e.g. readers each holding a copy while one writer keeps modifying its own.
+	//
+	// The chunks come from an arena that a graph shares with its copies. Freed chunks are
+	// reused from there, and the arena goes back to the heap in one go with the last of them.
+	// Nodes live by value in the chunks, so a reference to one lasts only until the next
+	// modifier.
+	//
+	// Edges are stored by value and move between chunks as others come and go, so unless weights
+	// are interned E must be nothrow movable. An edge iterator stays equal to others to the same
+	// edge, but only those returned since the last modifier may be moved or dereferenced.
+	//
+	// Layout picks how the edges are stored (see layout.hpp). It changes what operations cost,
+	// never what they do, so graphs of any layout behave identically.
+	template<typename N, typename E, typename Layout>
 	class graph {
 	public:
 		struct value_type {
@@ -23,10 +61,40 @@ namespace gdwg {
 			E weight;
 		};
 
+		// What an iterator dereferences to: the same three members as value_type, but referring
+		// into the graph instead of copying, so walking the edges never copies N or E. Structured
+		// bindings work on it as on value_type, and it converts to value_type for a copy.
+		struct reference {
+			N const& from;
+			N const& to;
+			E const& weight;
+
+			operator value_type() const { // NOLINT(google-explicit-constructor)
+				return value_type{from, to, weight};
+			}
+		};
+
+		// Dense handle for a node. Ids are below id_bound(). Erased nodes' ids are given to the next
+		// nodes inserted, the most recently freed first. A copy of a graph gives every node the same
+		// id it had in the original.
+		enum class node_id : std::uint32_t {};
+
+	private:
+		using edge_layout = typename detail::layout_traits<Layout>::edges;
+		static constexpr auto interned_weights = detail::layout_traits<Layout>::interned;
+		// What an edge record holds for its weight: the weight, or its handle in the storage's
+		// weight table.
+		using weight_ref = std::conditional_t<interned_weights, std::uint32_t, E>;
+
+	public:
+		// Edges refer to their endpoints by id; N is only looked at when ordering them.
 		struct edge {
-			N* src;
-			N* dst;
-			E weight;
+			node_id src;
+			node_id dst;
+			weight_ref weight;
+			// Numbered as the storage takes them in, from 1, so that an iterator stays equal to
+			// other iterators to its edge while edges before it come and go.
+			std::uint64_t serial = 0;
 		};
 
 		class iterator;
@@ -39,56 +107,175 @@ namespace gdwg {
 		}
 
 		template<typename InputIt>
-		graph(InputIt first, InputIt last){
-			for (auto& it = first; it != last; ++it) {
-				nodes_.emplace(std::make_shared<N>(*it));
-			}
+		graph(InputIt first, InputIt last)
+		: graph() {
+			insert_nodes(first, last);
 		}
 
 		// Copy Constructor
-		graph(graph const& other){
-			for (auto& it : other.nodes_) {
-				nodes_.emplace(std::make_shared<N>(*it));
-			}
-			for (auto& it : other.edges_) {
-				edges_.emplace(std::make_shared<edge>(*it));
-			}
-		}
+		graph(graph const& other) noexcept = default;
 
 		// Move Constructor
-		graph(graph&& other) noexcept
-		: nodes_{std::exchange(other.nodes_, std::set<std::shared_ptr<N>, node_cmp>())}
-		, edges_{std::exchange(other.edges_, std::set<std::shared_ptr<edge>, edge_cmp>())} {}
+		graph(graph&& other) noexcept = default;
 
 		// Copy Assignment
-		auto operator=(graph const& other) -> graph& {
-			if (this == &other) {
-				return *this;
-			}
-			auto obj = graph(other);
-			std::swap(nodes_, obj.nodes_);
-			std::swap(edges_, obj.edges_);
-			return *this;
-		}
+		auto operator=(graph const& other) noexcept -> graph& = default;
 
 		// Move Assignment
-		auto operator=(graph&& other) noexcept -> graph& {
-			std::swap(nodes_, other.nodes_);
-			std::swap(edges_, other.edges_);
-			return *this;
-		}
+		auto operator=(graph&& other) noexcept -> graph& = default;
+
+		~graph() = default;
 
 		// Modifiers
 		auto insert_node(N const& value) -> bool {
-			return nodes_.emplace(std::make_shared<N>(value)).second;
+			if (shared() and find_node(value) != nullptr) {
+				return false;
+			}
+			auto& s = own_state();
+			auto const hint = s.nodes.lower_bound(value, node_cmp{&s});
+			if (hint != s.nodes.end() and not(value < s.value(*hint))) {
+				return false;
+			}
+			s.emplace_node(hint, value);
+			return true;
+		}
+
+		// Inserts every value in [first, last) and returns how many weren't already nodes. The batch
+		// is sorted and deduplicated first, so that it is merged into the node set in one ordered
+		// sweep: each node goes in next to the previous one without searching the tree again.
+		template<typename InputIt>
+		auto insert_nodes(InputIt first, InputIt last) -> std::size_t {
+			auto batch = std::vector<N>(first, last);
+			if (batch.empty()) {
+				return 0;
+			}
+			std::sort(batch.begin(), batch.end());
+			batch.erase(std::unique(batch.begin(), batch.end()), batch.end());
+			if (shared() and std::ranges::all_of(batch, [this](N const& value) {
+				    return find_node(value) != nullptr;
+			    }))
+			{
+				return 0;
+			}
+
+			auto& s = own_state();
+			auto inserted = std::size_t{0};
+			// Every node before hint is less than the next value.
+			auto hint = s.nodes.begin();
+			for (auto const& value : batch) {
+				if (hint != s.nodes.end() and not(value < s.value(*hint))) {
+					hint = s.nodes.lower_bound(value, node_cmp{&s});
+					if (hint != s.nodes.end() and not(value < s.value(*hint))) {
+						continue;
+					}
+				}
+				hint = std::next(s.emplace_node(hint, value));
+				++inserted;
+			}
+			return inserted;
+		}
+
+		// Inserts every (from, to, weight) in [first, last) and returns how many weren't already
+		// edges. The batch is sorted and deduplicated and its endpoints resolved before anything is
+		// inserted, so nothing is inserted if an endpoint isn't a node. The edges are then merged
+		// into each index in that index's order, which on an empty graph is a linear build.
+		template<typename InputIt>
+		auto insert_edges(InputIt first, InputIt last) -> std::size_t {
+			auto batch = std::vector<value_type>(first, last);
+			std::sort(batch.begin(), batch.end(), [](value_type const& x, value_type const& y) {
+				return std::tie(x.from, x.to, x.weight) < std::tie(y.from, y.to, y.weight);
+			});
+
+			auto records = std::vector<edge_value>{};
+			records.reserve(batch.size());
+			node_record const* src = nullptr;
+			for (auto const& [from, to, weight] : batch) {
+				if (src == nullptr or not(src->value == from)) {
+					src = find_node(from);
+				}
+				auto const* dst = find_node(to);
+				if (src == nullptr or dst == nullptr) {
+					throw std::runtime_error("Cannot call gdwg::graph<N, E>::insert_edges when either "
+					                         "src or dst node does not exist");
+				}
+				records.push_back(edge_value{src->id, dst->id, weight});
+			}
+			batch = std::vector<value_type>{};
+			records.erase(std::unique(records.begin(),
+			                          records.end(),
+			                          [](edge_value const& x, edge_value const& y) {
+				                          return x.src == y.src and x.dst == y.dst
+				                                 and x.weight == y.weight;
+			                          }),
+			              records.end());
+			if (records.empty()
+			    or (shared() and std::ranges::all_of(records, [this](edge_value const& value) {
+				        return has_edge(value.src, value.dst, value.weight);
+			        })))
+			{
+				return 0;
+			}
+
+			// With no edges to merge with, the indices are built in order into a copy of the
+			// storage, which is kept only if every edge goes in.
+			if (state().edges.size() == 0) {
+				auto built = storage_ != nullptr ? std::make_shared<storage>(*storage_)
+				                                 : std::make_shared<storage>();
+				built->append_edges(records);
+				storage_ = std::move(built);
+				return records.size();
+			}
+
+			// records hold ids, which stay valid if own_state() copies the storage. Each edge is
+			// noted in added before it goes in, so that a failure takes out every edge added.
+			auto& s = own_state();
+			auto added = std::vector<edge>{};
+			added.reserve(records.size());
+			try {
+				auto const& front = records.front();
+				auto const first = typename storage::edge_key(s, front.src, front.dst, front.weight);
+				auto hint = s.edges.lower_bound(first.get());
+				for (auto const& value : records) {
+					auto const key = typename storage::edge_key(s, value.src, value.dst, value.weight);
+					hint = s.edges.lower_bound(hint, key.get());
+					if (s.edges.holds(hint, key.get())) {
+						continue;
+					}
+					added.push_back(key.get());
+					hint = std::next(s.insert_edge_at(hint, key.get()));
+				}
+			} catch (...) {
+				for (auto const& e : added) {
+					s.erase_edge(e);
+				}
+				throw;
+			}
+			return added.size();
 		}
 
 		auto insert_edge(N const& src, N const& dst, E const& weight) -> bool {
+			auto const* src_node = find_node(src);
+			auto const* dst_node = find_node(dst);
+			if (src_node != nullptr and dst_node != nullptr) {
+				if (shared() and has_edge(src_node->id, dst_node->id, weight)) {
+					return false;
+				}
+				auto& s = own_state();
+				auto const key = typename storage::edge_key(s, src_node->id, dst_node->id, weight);
+				return s.insert_edge_record(key.get());
+			}
+			throw std::runtime_error("Cannot call gdwg::graph<N, E>::insert_edge when either src "
+			                         "or dst node does not exist");
+		}
 
+		auto insert_edge(node_id src, node_id dst, E const& weight) -> bool {
 			if (is_node(src) and is_node(dst)) {
-				struct edge new_edge = {(*(nodes_.find(src))).get(), (*(nodes_.find(dst))).get(), weight};
-				return edges_.emplace(std::make_shared<edge>(new_edge)).second;
-
+				if (shared() and has_edge(src, dst, weight)) {
+					return false;
+				}
+				auto& s = own_state();
+				auto const key = typename storage::edge_key(s, src, dst, weight);
+				return s.insert_edge_record(key.get());
 			}
 			throw std::runtime_error("Cannot call gdwg::graph<N, E>::insert_edge when either src "
 			                         "or dst node does not exist");
@@ -96,148 +283,193 @@ namespace gdwg {
 
 
 		// relalce node
+		// log(n) + (in-degree + out-degree) * log(e)
 		auto replace_node(N const& old_data, N const& new_data) -> bool {
-			auto old_iterer = nodes_.find(old_data);
-			if (old_iterer != std::end(nodes_)){
+			if (is_node(old_data)){
 				if (is_node(new_data)) {
 					return false;
 				}
+				auto& s = own_state();
+				auto const old_id = *s.nodes.find(old_data, node_cmp{&s});
 				// insert new
-				auto new_node = std::make_shared<N>(new_data);
-				nodes_.emplace(new_node);
+				auto const new_id =
+				   *s.emplace_node(s.nodes.lower_bound(new_data, node_cmp{&s}), new_data);
 				// save all relevant edges
-				auto edge_ptrs = std::vector<std::shared_ptr<edge>>();
-				std::copy_if(edges_.begin(),
-				             edges_.end(),
-				             std::back_inserter(edge_ptrs),
-				             [&](auto const& edge_it) {
-					             return *(edge_it->src) == old_data or *(edge_it->dst) == old_data;
-				             });
+				auto const edges = s.incident_edges(old_id);
 				// replace the nodes
-				for (auto const& edge_it : edge_ptrs) {
-//					auto new_src_ptr = *(edge_it->src) == old_data ? new_node.get() : edge_it->src;
-//					auto new_dst_ptr = *(edge_it->dst) == old_data ? new_node.get() : edge_it->dst;
-					auto new_src_ptr = edge_it->src;
-					auto new_dst_ptr = edge_it->dst;
-					if (*(edge_it->src) == old_data){
-						new_src_ptr = new_node.get();
-					}
-					if (*(edge_it->dst) == old_data){
-						new_dst_ptr = new_node.get();
-					}
+				for (auto const& e : edges) {
+					auto const new_src = e.src == old_id ? new_id : e.src;
+					auto const new_dst = e.dst == old_id ? new_id : e.dst;
 					// insert new and remove old
-					edges_.emplace(std::make_shared<edge>(edge{new_src_ptr, new_dst_ptr, edge_it->weight}));
-					edges_.erase(edge_it);
+					s.insert_edge_record(edge{new_src, new_dst, e.weight});
+					s.erase_edge(e);
 				}
 				// erase old node
-				nodes_.erase(old_iterer);
+				s.erase_node(old_id);
 				return true;
 			}
 			throw std::runtime_error("Cannot call gdwg::graph<N, E>::replace_node on a node that "
 			                         "doesn't exist");
 		}
 
+		// log(n) + (in-degree + out-degree) * log(e)
 		auto merge_replace_node(N const& old_data, N const& new_data) -> void {
-			auto old_it = nodes_.find(old_data);
-			auto new_it = nodes_.find(new_data);
-			if (old_it == nodes_.end() or new_it == nodes_.end()) {
+			if (not is_node(old_data) or not is_node(new_data)) {
 				throw std::runtime_error("Cannot call gdwg::graph<N, E>::merge_replace_node on old or "
 				                         "new data if they don't exist in the graph");
 			}
+			// Merging a node into itself leaves the graph as it is.
+			if (old_data == new_data) {
+				return;
+			}
+			auto& s = own_state();
+			auto const old_id = *s.nodes.find(old_data, node_cmp{&s});
+			auto const new_id = *s.nodes.find(new_data, node_cmp{&s});
 
 			// save all relevant edges
-			auto edge_ptrs = std::vector<std::shared_ptr<edge>>();
-			std::copy_if(edges_.begin(),
-			             edges_.end(),
-			             std::back_inserter(edge_ptrs),
-			             [&](auto const& e_ptr) {
-				             return *(e_ptr->src) == old_data or *(e_ptr->dst) == old_data;
-			             });
+			auto const edges = s.incident_edges(old_id);
 
 			// merge nodes
-			for (auto const& e_ptr : edge_ptrs) {
-				auto new_src_ptr = e_ptr->src;
-				auto new_dst_ptr = e_ptr->dst;
-				if (*(e_ptr->src) == old_data){
-					new_src_ptr = (*new_it).get();
-				}
-				if (*(e_ptr->dst) == old_data){
-					new_dst_ptr = (*new_it).get();
-				}
-				struct edge new_edge = edge{new_src_ptr, new_dst_ptr, e_ptr->weight};
-				edges_.erase(e_ptr);
-
-				//	check if edge already exists
-				if (edges_.find(new_edge) == edges_.end()) {
-					edges_.emplace(std::make_shared<edge>(new_edge));
-				}
+			for (auto const& e : edges) {
+				auto const new_src = e.src == old_id ? new_id : e.src;
+				auto const new_dst = e.dst == old_id ? new_id : e.dst;
+				// does nothing if the edge already exists; goes in first so that the weight is
+				// still held
+				s.insert_edge_record(edge{new_src, new_dst, e.weight});
+				s.erase_edge(e);
 			}
 			// delete old node
-			nodes_.erase(old_it);
+			s.erase_node(old_id);
 		}
 
+		// log(n) + (in-degree + out-degree) * log(e)
 		auto erase_node(N const& value) -> bool {
 			if (is_node(value)) {
-				std::erase_if(edges_, [&](auto const& ed) { return *(ed->src) == value or *(ed->dst) == value; });
-				nodes_.erase(nodes_.find(value));
+				auto& s = own_state();
+				auto const id = *s.nodes.find(value, node_cmp{&s});
+				for (auto const& e : s.incident_edges(id)) {
+					s.erase_edge(e);
+				}
+				s.erase_node(id);
 				return true;
 			}
 			return false;
 		}
 
-		// log(n) + e
+		// log(e), plus log(n) to tell a missing edge from a missing node
 		auto erase_edge(N const& src, N const& dst, E const& weight) -> bool {
-			if (is_node(src) and is_node(dst)){
-				auto it = std::find_if(edges_.begin(), edges_.end(),
-				                       [&](auto const& ed) { return *(ed->src) == src and *(ed->dst) == dst and ed->weight == weight; });
-				if (it != edges_.end()) {
-					edges_.erase(it);
-					return true;
-				}
+			auto const* src_node = find_node(src);
+			auto const* dst_node = find_node(dst);
+			if (src_node == nullptr or dst_node == nullptr) {
+				throw std::runtime_error("Cannot call gdwg::graph<N, E>::erase_edge on src or dst if "
+				                         "they don't exist in the graph");
+			}
+			auto const key = state().find_edge_key(src_node->id, dst_node->id, weight);
+			auto const& edges = state().edges;
+			auto it = key ? edges.find(*key) : edges.end();
+			if (it == edges.end()) {
 				return false;
 			}
-			throw std::runtime_error("Cannot call gdwg::graph<N, E>::erase_edge on src or dst if they "
-			                         "don't exist in the graph");
+			own_edge(it);
+			storage_->erase_edge_at(it);
+			return true;
+		}
+
+		// Erases every (from, to, weight) in [first, last) that is an edge and returns how many were
+		// erased. The batch is sorted first so that runs of neighbouring edges are erased without
+		// searching the tree again. Nothing is erased if any endpoint isn't a node.
+		template<typename InputIt>
+		auto erase_edges(InputIt first, InputIt last) -> std::size_t {
+			auto batch = std::vector<value_type>(first, last);
+			std::sort(batch.begin(), batch.end(), [](value_type const& x, value_type const& y) {
+				return std::tie(x.from, x.to, x.weight) < std::tie(y.from, y.to, y.weight);
+			});
+			for (auto it = batch.begin(); it != batch.end(); ++it) {
+				auto const new_src = it == batch.begin() or not(std::prev(it)->from == it->from);
+				if ((new_src and not is_node(it->from)) or not is_node(it->to)) {
+					throw std::runtime_error("Cannot call gdwg::graph<N, E>::erase_edges on src or dst "
+					                         "if they don't exist in the graph");
+				}
+			}
+			if (batch.empty()
+			    or (shared() and std::ranges::none_of(batch, [this](value_type const& value) {
+				        return find(value.from, value.to, value.weight) != end();
+			        })))
+			{
+				return 0;
+			}
+
+			auto& s = own_state();
+			auto erased = std::size_t{0};
+			auto hint = s.edges.end();
+			node_record const* src = nullptr;
+			for (auto const& [from, to, weight] : batch) {
+				if (src == nullptr or not(src->value == from)) {
+					src = find_node(from);
+				}
+				auto const key = s.find_edge_key(src->id, find_node(to)->id, weight);
+				if (not key) {
+					continue;
+				}
+				auto const hit = hint != s.edges.end() and not s.edges.less(*key, *hint)
+				                 and not s.edges.less(*hint, *key);
+				auto const it = hit ? hint : s.edges.find(*key);
+				if (it != s.edges.end()) {
+					hint = s.erase_edge_at(it);
+					++erased;
+				}
+			}
+			return erased;
 		}
 
 		auto erase_edge(iterator i) -> iterator {
 			if (i == end() or i == iterator{}) {
 				return end();
 			}
-			return iterator{edges_.erase(i.iter_)};
+			own_edge(i.iter_);
+			return make_iterator(storage_->erase_edge_at(i.iter_));
 		}
 
 		auto erase_edge(iterator i, iterator s) -> iterator {
-			return iterator{edges_.erase(i.iter_, s.iter_)};
+			if (i == s) {
+				return i;
+			}
+			auto it = i.iter_;
+			auto last = s.iter_;
+			own_edges(it, last);
+			// Counted first: in the adjacency layout, erasing moves a node's later edges, which
+			// may include last.
+			for (auto n = std::distance(it, last); n > 0; --n) {
+				it = storage_->erase_edge_at(it);
+			}
+			return make_iterator(it);
 		}
 
+		// Lets go of everything. The last graph sharing the storage destroys it in one sweep,
+		// handing back all of its memory.
 		auto clear() noexcept -> void {
-			nodes_.clear();
-			edges_.clear();
+			storage_.reset();
 		}
 
 
 		// Accessors
 		[[nodiscard]] auto is_node(N const& value) const -> bool {
-			if (nodes_.find(value) == nodes_.end()) {
+			if (find_node(value) == nullptr) {
 				return false;
 			}
 			return true;
 		}
 
 		[[nodiscard]] auto empty() const -> bool {
-			return nodes_.empty();
+			return state().nodes.empty();
 		}
 
+		// log(e)
 		[[nodiscard]] auto is_connected(N const& src, N const& dst) const -> bool {
-			if (is_node(src) and is_node(dst)) {
-				auto connection = std::find_if(edges_.begin(),
-				                               edges_.end(),
-				                               [src, dst](std::shared_ptr<edge> x) {
-					                               return (*(x->src) == src and *(x->dst) == dst);
-				                               });
-				return connection != edges_.end();
-
+			auto const* src_node = find_node(src);
+			auto const* dst_node = find_node(dst);
+			if (src_node != nullptr and dst_node != nullptr) {
+				return state().edges.contains(src_node->id, dst_node->id);
 			}
 			throw std::runtime_error("Cannot call gdwg::graph<N, E>::is_connected if src or dst node "
 			                         "don't exist in the graph");
@@ -245,21 +477,19 @@ namespace gdwg {
 
 		[[nodiscard]] auto nodes() const -> std::vector<N> {
 			auto v = std::vector<N>{};
-			for (auto const& node_it : nodes_){
-				v.emplace_back(*node_it);
+			auto const& s = state();
+			for (auto const id : s.nodes){
+				v.emplace_back(s.value(id));
 			}
 			return v;
 		}
 
+		// log(e) + out-degree
 		[[nodiscard]] auto weights(N const& src, N const& dst) const -> std::vector<E> {
-			if (is_node(src) and is_node(dst)) {
-				auto v = std::vector<E>{};
-				for (auto const& edge_it : edges_) {
-					if (*(edge_it->src) == src and *(edge_it->dst) == dst) {
-						v.emplace_back(edge_it->weight);
-					}
-				}
-				return v;
+			auto const* src_node = find_node(src);
+			auto const* dst_node = find_node(dst);
+			if (src_node != nullptr and dst_node != nullptr) {
+				return weights_of(src_node->id, dst_node->id);
 			}
 			throw std::runtime_error("Cannot call gdwg::graph<N, E>::weights if src or dst node "
 			                         "don't exist in the graph");
@@ -267,17 +497,24 @@ namespace gdwg {
 
 		// log(n)+log(e)
 		[[nodiscard]] auto find(N const& src, N const& dst, E const& weight) const -> iterator {
-			return iterator{edges_.find(value_type{src, dst, weight})};
+			auto const* src_node = find_node(src);
+			auto const* dst_node = find_node(dst);
+			if (src_node == nullptr or dst_node == nullptr) {
+				return end();
+			}
+			auto const& s = state();
+			auto const key = s.find_edge_key(src_node->id, dst_node->id, weight);
+			return key ? make_iterator(s.edges.find(*key)) : end();
 		}
 
-		// log(n) + log(e)
+		// log(n) + log(e) + out-degree
 		[[nodiscard]] auto connections(N const& src) const -> std::vector<N> {
-			if (is_node(src)) {
+			if (auto const* node = find_node(src)) {
+				auto const& s = state();
+				auto const [first, last] = s.edges.out_range(node->id);
 				auto v = std::vector<N>{};
-				std::for_each(edges_.begin(), edges_.end(), [&v, &src](auto const& edge_it) {
-					if (*(edge_it->src) == src) {
-						v.emplace_back(*(edge_it->dst));
-					}
+				std::transform(first, last, std::back_inserter(v), [&s](edge const& e) {
+					return s.value(e.dst);
 				});
 				return v;
 			}
@@ -285,101 +522,1355 @@ namespace gdwg {
 			                         "exist in the graph");
 		}
 
+		// log(n) + log(e) + in-degree
+		[[nodiscard]] auto incoming(N const& dst) const -> std::vector<N> {
+			if (auto const* node = find_node(dst)) {
+				auto const& s = state();
+				auto v = std::vector<N>{};
+				std::ranges::transform(s.edges.in_range(node->id),
+				                       std::back_inserter(v),
+				                       [&s](node_id src) { return s.value(src); });
+				return v;
+			}
+			throw std::runtime_error("Cannot call gdwg::graph<N, E>::incoming if dst doesn't "
+			                         "exist in the graph");
+		}
+
+		// Views. Like nodes(), connections() and weights(), but lazy: they refer into the graph
+		// instead of copying into a vector, so they cost nothing until iterated and compose with
+		// std::views. A view is invalidated by anything that would invalidate an iterator.
+		[[nodiscard]] auto nodes_view() const {
+			return state().nodes | std::views::transform([s = &state()](node_id id) -> N const& {
+				       return s->value(id);
+			       });
+		}
+
+		// log(n) + log(e)
+		[[nodiscard]] auto connections_view(N const& src) const {
+			if (auto const* node = find_node(src)) {
+				auto const [first, last] = state().edges.out_range(node->id);
+				return std::ranges::subrange(first, last)
+				       | std::views::transform([s = &state()](edge const& e) -> N const& {
+					         return s->value(e.dst);
+				         });
+			}
+			throw std::runtime_error("Cannot call gdwg::graph<N, E>::connections_view if src "
+			                         "doesn't exist in the graph");
+		}
+
+		// log(n) + log(e)
+		[[nodiscard]] auto weights_view(N const& src, N const& dst) const {
+			auto const* src_node = find_node(src);
+			auto const* dst_node = find_node(dst);
+			if (src_node != nullptr and dst_node != nullptr) {
+				auto const* s = &state();
+				auto const [first, last] = s->edges.out_range(src_node->id, dst_node->id);
+				return std::ranges::subrange(first, last)
+				       | std::views::transform(
+				          [s](edge const& e) -> E const& { return s->weight(e); });
+			}
+			throw std::runtime_error("Cannot call gdwg::graph<N, E>::weights_view if src or dst "
+			                         "node don't exist in the graph");
+		}
+
+		// Node ids. These skip the lookup by value, so callers that keep ids around only pay for
+		// integer comparisons until two different nodes have to be ordered.
+		[[nodiscard]] auto id_of(N const& value) const -> std::optional<node_id> {
+			if (auto const* node = find_node(value)) {
+				return node->id;
+			}
+			return std::nullopt;
+		}
+
+		// Every id handed out so far is less than this, so it sizes arrays indexed by node id.
+		[[nodiscard]] auto id_bound() const noexcept -> std::size_t {
+			return state().id_bound;
+		}
+
+		[[nodiscard]] auto is_node(node_id id) const noexcept -> bool {
+			return id_index(id) < id_bound() and state().by_id[id_index(id)].node.has_value();
+		}
+
+		[[nodiscard]] auto node(node_id id) const -> N const& {
+			if (is_node(id)) {
+				return state().value(id);
+			}
+			throw std::runtime_error("Cannot call gdwg::graph<N, E>::node on an id that doesn't "
+			                         "belong to a node in the graph");
+		}
+
+		// log(e)
+		[[nodiscard]] auto is_connected(node_id src, node_id dst) const -> bool {
+			if (is_node(src) and is_node(dst)) {
+				return state().edges.contains(src, dst);
+			}
+			throw std::runtime_error("Cannot call gdwg::graph<N, E>::is_connected if src or dst node "
+			                         "don't exist in the graph");
+		}
+
+		// log(e) + out-degree
+		[[nodiscard]] auto weights(node_id src, node_id dst) const -> std::vector<E> {
+			if (is_node(src) and is_node(dst)) {
+				return weights_of(src, dst);
+			}
+			throw std::runtime_error("Cannot call gdwg::graph<N, E>::weights if src or dst node "
+			                         "don't exist in the graph");
+		}
+
+		// log(e) + out-degree
+		[[nodiscard]] auto connections(node_id src) const -> std::vector<node_id> {
+			if (is_node(src)) {
+				auto const [first, last] = state().edges.out_range(src);
+				auto v = std::vector<node_id>{};
+				std::transform(first, last, std::back_inserter(v), [](edge const& e) {
+					return e.dst;
+				});
+				return v;
+			}
+			throw std::runtime_error("Cannot call gdwg::graph<N, E>::connections if src doesn't "
+			                         "exist in the graph");
+		}
+
+		// log(e) + in-degree
+		[[nodiscard]] auto incoming(node_id dst) const -> std::vector<node_id> {
+			if (is_node(dst)) {
+				auto v = std::vector<node_id>{};
+				std::ranges::copy(state().edges.in_range(dst), std::back_inserter(v));
+				return v;
+			}
+			throw std::runtime_error("Cannot call gdwg::graph<N, E>::incoming if dst doesn't "
+			                         "exist in the graph");
+		}
+
+		// log(e). Lazy, as the other views: every edge leaving src as a (dst, weight) pair, in edge
+		// order, for traversals that would otherwise ask for connections() and then weights().
+		[[nodiscard]] auto out_edges(node_id src) const {
+			if (is_node(src)) {
+				auto const* s = &state();
+				auto const [first, last] = s->edges.out_range(src);
+				return std::ranges::subrange(first, last)
+				       | std::views::transform([s](edge const& e) -> std::pair<node_id, E const&> {
+					         return {e.dst, s->weight(e)};
+				         });
+			}
+			throw std::runtime_error("Cannot call gdwg::graph<N, E>::out_edges if src doesn't "
+			                         "exist in the graph");
+		}
+
+		// Snapshot in compressed sparse row form, built in O(n + e) from the already-sorted edges.
+		[[nodiscard]] auto freeze() const -> frozen_graph<N, E> {
+			using index_type = typename frozen_graph<N, E>::index_type;
+			auto const& s = state();
+			auto nodes = std::vector<N>{};
+			nodes.reserve(s.nodes.size());
+			auto position = std::vector<index_type>(id_bound());
+			for (auto const id : s.nodes) {
+				position[id_index(id)] = static_cast<index_type>(nodes.size());
+				nodes.push_back(s.value(id));
+			}
+
+			auto offsets = std::vector<std::size_t>(nodes.size() + 1, 0);
+			auto targets = std::vector<index_type>{};
+			auto weights = std::vector<E>{};
+			targets.reserve(s.edges.size());
+			weights.reserve(s.edges.size());
+			for (auto const& e : s.edges) {
+				++offsets[position[id_index(e.src)] + 1];
+				targets.push_back(position[id_index(e.dst)]);
+				weights.push_back(s.weight(e));
+			}
+			std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+			return frozen_graph<N, E>(std::move(nodes),
+			                          std::move(offsets),
+			                          std::move(targets),
+			                          std::move(weights));
+		}
+
+		// Binary format, version 1. All integers are little-endian.
+		//     "GDWG", u32 version, u64 node count
+		//     every node, in order, through serializer<N>
+		//     for every node in order: u64 out-degree, then out-degree times
+		//         u32 index of dst in the node list, the weight through serializer<E>
+		// Edges are written in the graph's own order, so load() rebuilds the indices without
+		// searching them. Node ids aren't saved: a loaded graph numbers its nodes in order.
+		auto save(std::ostream& os) const -> void {
+			auto const& s = state();
+			os.write(file_magic, sizeof(file_magic));
+			detail::write_raw(os, file_version);
+			detail::write_raw(os, static_cast<std::uint64_t>(s.nodes.size()));
+			auto position = std::vector<std::uint32_t>(id_bound());
+			auto index = std::uint32_t{0};
+			for (auto const id : s.nodes) {
+				position[id_index(id)] = index++;
+				serializer<N>::write(os, s.value(id));
+			}
+
+			// As in operator<<, each node's edges follow the previous node's.
+			auto first = s.edges.begin();
+			for (auto const id : s.nodes) {
+				auto last = first;
+				while (last != s.edges.end() and last->src == id) {
+					++last;
+				}
+				detail::write_raw(os, static_cast<std::uint64_t>(std::distance(first, last)));
+				for (; first != last; ++first) {
+					detail::write_raw(os, position[id_index(first->dst)]);
+					serializer<E>::write(os, s.weight(*first));
+				}
+			}
+		}
+
+		// Replaces the graph with one written by save(). Throws, leaving the graph as it was, if
+		// the stream doesn't hold a graph in a version this code reads.
+		auto load(std::istream& is) -> void {
+			auto g = graph();
+			auto& s = g.own_state();
+			auto const corrupt = [] {
+				return std::runtime_error("Cannot call gdwg::graph<N, E>::load on a stream that "
+				                          "doesn't hold a saved graph");
+			};
+
+			char magic[sizeof(file_magic)];
+			is.read(magic, sizeof(magic));
+			auto const version = detail::read_raw<std::uint32_t>(is);
+			if (not is or not std::equal(magic, magic + sizeof(magic), file_magic)
+			    or version != file_version)
+			{
+				throw corrupt();
+			}
+
+			// Nodes come in order, so each one is appended and gets the next id: its index.
+			auto const num_nodes = detail::read_raw<std::uint64_t>(is);
+			if (num_nodes > std::numeric_limits<std::uint32_t>::max()) {
+				throw corrupt();
+			}
+			for (auto i = std::uint64_t{0}; is and i < num_nodes; ++i) {
+				auto value = serializer<N>::read(is);
+				if (not is or (i > 0 and not(s.value(*std::prev(s.nodes.end())) < value))) {
+					throw corrupt();
+				}
+				s.emplace_node(s.nodes.end(), value);
+			}
+
+			auto records = std::vector<edge_value>{};
+			for (auto i = std::uint64_t{0}; is and i < num_nodes; ++i) {
+				auto const src = static_cast<node_id>(i);
+				auto const degree = detail::read_raw<std::uint64_t>(is);
+				for (auto j = std::uint64_t{0}; is and j < degree; ++j) {
+					auto const dst = detail::read_raw<std::uint32_t>(is);
+					auto weight = serializer<E>::read(is);
+					if (not is or dst >= num_nodes) {
+						throw corrupt();
+					}
+					// Within a source, edges go up by dst and then by weight. Ids are in node order
+					// here, so comparing them compares the nodes.
+					if (j > 0) {
+						auto const& prev = records.back();
+						auto const prev_dst = static_cast<std::uint32_t>(prev.dst);
+						if (dst < prev_dst or (dst == prev_dst and not(prev.weight < weight))) {
+							throw corrupt();
+						}
+					}
+					records.push_back(edge_value{src, static_cast<node_id>(dst), std::move(weight)});
+				}
+			}
+			if (not is) {
+				throw corrupt();
+			}
+			s.append_edges(records);
+			*this = std::move(g);
+		}
+
+		// Replaces the graph with the one in a text edge list, as published by SNAP and KONECT:
+		// one "src dst [weight]" per line, with fields separated by whitespace or commas. Lines
+		// without a weight get default_weight, and every endpoint becomes a node. Throws, leaving
+		// the graph as it was, on a line that doesn't parse, naming the line; a NaN doesn't parse,
+		// as it can't be ordered.
+		auto load_edge_list(std::istream& is, E const& default_weight = E{1}) -> void
+		requires detail::number_field<N> and detail::number_field<E>
+		{
+			using reader = detail::edge_list_reader<N, E>;
+			auto parsed = std::vector<value_type>{};
+			auto line = reader(is, default_weight);
+			auto e = value_type{};
+			auto result = typename reader::result{};
+			while ((result = line.next(e.from, e.to, e.weight)) == reader::result::edge) {
+				parsed.push_back(e);
+			}
+			if (result == reader::result::malformed) {
+				throw std::runtime_error("Cannot call gdwg::graph<N, E>::load_edge_list on a stream "
+				                         "with a line that isn't an edge (line "
+				                         + std::to_string(line.line()) + ")");
+			}
+			if (is.bad()) {
+				throw std::runtime_error("Cannot call gdwg::graph<N, E>::load_edge_list on a stream "
+				                         "with a line that isn't an edge");
+			}
+
+			// Published datasets number their nodes densely. When N is an integer type and the
+			// values span less than twice the number of edges, a table indexed by value collects the
+			// distinct values in order and maps each endpoint to its id with no sorting or searching.
+			auto values = std::vector<N>{};
+			auto table = std::vector<node_id>{};
+			auto low = std::uint64_t{0};
+			if constexpr (std::integral<N>) {
+				if (not parsed.empty()) {
+					auto min = parsed.front().from;
+					auto max = min;
+					for (auto const& [from, to, weight] : parsed) {
+						min = std::min({min, from, to});
+						max = std::max({max, from, to});
+					}
+					low = static_cast<std::uint64_t>(min);
+					auto const span = static_cast<std::uint64_t>(max) - low;
+					if (span < 2 * static_cast<std::uint64_t>(parsed.size())) {
+						auto const absent = node_id{std::numeric_limits<std::uint32_t>::max()};
+						table.assign(static_cast<std::size_t>(span) + 1, absent);
+						for (auto const& [from, to, weight] : parsed) {
+							table[static_cast<std::size_t>(static_cast<std::uint64_t>(from) - low)] = {};
+							table[static_cast<std::size_t>(static_cast<std::uint64_t>(to) - low)] = {};
+						}
+						for (auto i = std::size_t{0}; i < table.size(); ++i) {
+							if (table[i] != absent) {
+								table[i] = static_cast<node_id>(values.size());
+								values.push_back(static_cast<N>(low + i));
+							}
+						}
+					}
+				}
+			}
+			if (table.empty()) {
+				values.reserve(2 * parsed.size());
+				for (auto const& [from, to, weight] : parsed) {
+					values.push_back(from);
+					values.push_back(to);
+				}
+				std::sort(values.begin(), values.end());
+				values.erase(std::unique(values.begin(), values.end()), values.end());
+			}
+
+			// As in load(), nodes are appended in order, so a node's id is its index in values
+			// and ordering edges by id orders them as the edge set does.
+			auto g = graph();
+			auto& s = g.own_state();
+			for (auto const& value : values) {
+				s.emplace_node(s.nodes.end(), value);
+			}
+			auto records = std::vector<edge_value>{};
+			records.reserve(parsed.size());
+			auto const resolve = [&parsed, &records](auto id_of) {
+				for (auto const& [from, to, weight] : parsed) {
+					records.push_back(edge_value{id_of(from), id_of(to), weight});
+				}
+			};
+			if (not table.empty()) {
+				resolve([&table, low](N const& value) {
+					return table[static_cast<std::size_t>(static_cast<std::uint64_t>(value) - low)];
+				});
+			}
+			else {
+				resolve([&values](N const& value) {
+					return static_cast<node_id>(std::lower_bound(values.begin(), values.end(), value)
+					                            - values.begin());
+				});
+			}
+			parsed = std::vector<value_type>{};
+			std::sort(records.begin(), records.end(), [](edge_value const& x, edge_value const& y) {
+				return std::tie(x.src, x.dst, x.weight) < std::tie(y.src, y.dst, y.weight);
+			});
+			records.erase(std::unique(records.begin(),
+			                          records.end(),
+			                          [](edge_value const& x, edge_value const& y) {
+				                          return x.src == y.src and x.dst == y.dst
+				                                 and x.weight == y.weight;
+			                          }),
+			              records.end());
+			s.append_edges(records);
+			*this = std::move(g);
+		}
+
+		// Order-independent hash of the nodes and edges, kept up to date by every modifier, so
+		// reading it is O(1). Equal graphs have equal fingerprints and unequal ones almost never
+		// do, so it serves as a cache key. Parts of a graph whose type has no std::hash add
+		// nothing, so without std::hash for N or E the fingerprint carries less information.
+		[[nodiscard]] auto fingerprint() const noexcept -> std::uint64_t {
+			return state().fingerprint;
+		}
+
 		// Iterator
 		[[nodiscard]] auto begin() const -> iterator {
-			return iterator{edges_.begin()};
+			return make_iterator(state().edges.begin());
 		}
 
 		[[nodiscard]] auto end() const -> iterator {
-			return iterator{edges_.end()};
+			return make_iterator(state().edges.end());
 		}
 
 		// Comparision
 		[[nodiscard]] auto operator==(graph const& other) const -> bool {
-			if (other.nodes_.size() == nodes_.size() and other.edges_.size() == edges_.size()) {
-				return std::equal(nodes_.begin(), nodes_.end(), other.nodes_.begin(),
-				                  [](auto const& x, auto const& y) { return *x == *y; })
-				       and std::equal(edges_.begin(), edges_.end(), other.edges_.begin(),
-				                      [](auto const& x, auto const& y) {
-					                      return *(x->src) == *(y->src)
-					                         and *(x->dst) == *(y->dst)
-					                         and x->weight== y->weight; });
+			auto const& x = state();
+			auto const& y = other.state();
+			if (&x == &y) {
+				return true;
+			}
+			if (x.fingerprint != y.fingerprint) {
+				return false;
+			}
+			if (y.nodes.size() == x.nodes.size() and y.edges.size() == x.edges.size()) {
+				return std::equal(x.nodes.begin(), x.nodes.end(), y.nodes.begin(),
+				                  [&x, &y](node_id a, node_id b) { return x.value(a) == y.value(b); })
+				       and std::equal(x.edges.begin(), x.edges.end(), y.edges.begin(),
+				                      [&x, &y](edge const& a, edge const& b) {
+					                      return x.value(a.src) == y.value(b.src)
+					                         and x.value(a.dst) == y.value(b.dst)
+					                         and x.weight(a) == y.weight(b); });
 			}
 			return false;
 		}
 
 	private:
+		struct node_record {
+			N value;
+			node_id id;
+			std::uint64_t hash;
+		};
+
+		static constexpr auto no_id = node_id{std::numeric_limits<std::uint32_t>::max()};
+
+		// What the table indexed by node id holds for an id: its node, or if it has none the next
+		// free id.
+		struct node_slot {
+			std::optional<node_record> node;
+			node_id next_free = no_id;
+		};
+
+		// An edge with its weight in full, for batches sorted before any edge record is made.
+		struct edge_value {
+			node_id src;
+			node_id dst;
+			E weight;
+		};
+
+		struct storage;
+
+		static constexpr char file_magic[4] = {'G', 'D', 'W', 'G'};
+		static constexpr auto file_version = std::uint32_t{1};
+
+		static constexpr auto id_index(node_id id) noexcept -> std::size_t {
+			return static_cast<std::size_t>(id);
+		}
+
+		// A node id with its value looked up, for a key that a search compares many times.
+		struct node_ref {
+			node_id id;
+			N const* value;
+		};
+
+		// Orders node ids by their nodes' values.
 		struct node_cmp {
-			using is_transparent = void;
+			storage const* s = nullptr;
+
+			auto operator()(node_id x, node_id y) const -> bool {
+				return s->less(x, y);
+			}
+
+			auto operator()(node_id x, node_ref const& y) const -> bool {
+				return s->less(x, y);
+			}
 
-			auto operator()(std::shared_ptr<N> const& x, std::shared_ptr<N> const& y) const -> bool {
-				return *x < *y;
+			auto operator()(node_ref const& x, node_id y) const -> bool {
+				return s->less(x, y);
 			}
 
-			auto operator()(std::shared_ptr<N> const& x, N const& y) const -> bool {
-				return *x < y;
+			auto operator()(node_id x, N const& y) const -> bool {
+				return s->value(x) < y;
 			}
 
-			auto operator()(N const& x, std::shared_ptr<N> const& y) const -> bool {
-				return x < *y;
+			auto operator()(N const& x, node_id y) const -> bool {
+				return x < s->value(y);
 			}
 		};
-		
+
+		// Keys into the edge set, which is ordered by (src, dst, weight), so every edge leaving
+		// src (or going from src to dst) is one contiguous equal_range.
+		struct src_key {
+			node_ref src;
+		};
+
+		struct src_dst_key {
+			node_ref src;
+			node_ref dst;
+		};
+
+		struct edge_key_ref {
+			node_ref src;
+			node_ref dst;
+			weight_ref const* weight;
+		};
+
+		struct dst_key {
+			node_ref dst;
+		};
 
 		struct edge_cmp {
-			using is_transparent = void;
+			storage const* s = nullptr;
+
+			auto operator()(edge const& x, edge const& y) const -> bool {
+				if (x.src != y.src) {
+					return s->less(x.src, y.src);
+				}
+				if (x.dst != y.dst) {
+					return s->less(x.dst, y.dst);
+				}
+				return s->less_weight(x.weight, y.weight);
+			}
+
+			auto operator()(edge const& x, edge_key_ref const& y) const -> bool {
+				if (x.src != y.src.id) {
+					return s->less(x.src, y.src);
+				}
+				if (x.dst != y.dst.id) {
+					return s->less(x.dst, y.dst);
+				}
+				return s->less_weight(x.weight, *y.weight);
+			}
 
-			auto operator()(std::shared_ptr<edge> const& x, std::shared_ptr<edge> const& y) const
-			   -> bool {
-				return std::tie(*(x->src), *(x->dst), x->weight)
-				       < std::tie(*(y->src), *(y->dst), y->weight);
+			auto operator()(edge_key_ref const& x, edge const& y) const -> bool {
+				if (x.src.id != y.src) {
+					return s->less(x.src, y.src);
+				}
+				if (x.dst.id != y.dst) {
+					return s->less(x.dst, y.dst);
+				}
+				return s->less_weight(*x.weight, y.weight);
 			}
 
-			auto operator()(std::shared_ptr<edge> const& x, struct edge const& y) const -> bool {
-				return std::tie(*(x->src), *(x->dst), x->weight)
-				       < std::tie(*(y.src), *(y.dst), y.weight);
+			auto operator()(edge const& x, src_key const& y) const -> bool {
+				return s->less(x.src, y.src);
 			}
 
-			auto operator()(struct edge const& x, std::shared_ptr<edge> const& y) const -> bool {
-				return std::tie(*(x.src), *(x.dst), x.weight)
-				       < std::tie(*(y->src), *(y->dst), y->weight);
+			auto operator()(src_key const& x, edge const& y) const -> bool {
+				return s->less(x.src, y.src);
 			}
 
-			auto operator()(std::shared_ptr<edge> const& x, struct value_type const& y) const
-			   -> bool {
-				return std::tie(*(x->src), *(x->dst), x->weight)
-				       < std::tie(y.from, y.to, y.weight);
+			auto operator()(edge const& x, src_dst_key const& y) const -> bool {
+				return x.src != y.src.id ? s->less(x.src, y.src) : s->less(x.dst, y.dst);
 			}
 
-			auto operator()(struct value_type const& x, std::shared_ptr<edge> const& y) const
-			   -> bool {
-				return std::tie(x.from, x.to, x.weight)
-				       < std::tie(*(y->src), *(y->dst), y->weight);
+			auto operator()(src_dst_key const& x, edge const& y) const -> bool {
+				return x.src.id != y.src ? s->less(x.src, y.src) : s->less(x.dst, y.dst);
 			}
 		};
 
-		std::set<std::shared_ptr<N>, node_cmp> nodes_;
-		std::set<std::shared_ptr<edge>, edge_cmp> edges_;
+		// An edge as the reverse index holds it. Parallel edges give equal entries: finding any
+		// of them is enough, as the weights are in the edge set.
+		struct in_entry {
+			node_id dst;
+			node_id src;
+		};
+
+		struct in_key {
+			node_ref dst;
+			node_ref src;
+		};
+
+		// Reverse index over the same edges as the edge set, ordered by (dst, src), so the edges
+		// entering a node are one contiguous equal_range.
+		struct in_edge_cmp {
+			storage const* s = nullptr;
+
+			auto operator()(in_entry const& x, in_key const& y) const -> bool {
+				return x.dst != y.dst.id ? s->less(x.dst, y.dst) : s->less(x.src, y.src);
+			}
+
+			auto operator()(in_key const& x, in_entry const& y) const -> bool {
+				return x.dst.id != y.dst ? s->less(x.dst, y.dst) : s->less(x.src, y.src);
+			}
+
+			auto operator()(in_entry const& x, dst_key const& y) const -> bool {
+				return s->less(x.dst, y.dst);
+			}
+
+			auto operator()(dst_key const& x, in_entry const& y) const -> bool {
+				return s->less(x.dst, y.dst);
+			}
+		};
+
+		using node_tree = detail::btree<node_id>;
+
+		// The edge indices, one class per layout. Both list the edges in (src, dst, weight) order
+		// through const_iterator, and find edges leaving a node, going between two nodes or
+		// entering a node. A position is where an edge is or would go among its src's outgoing
+		// edges; it is cheaper than a const_iterator and only used to look up and insert. Both
+		// keep each edge once by source and once by destination, in trees that copies of the
+		// storage share.
+
+		// layout::edge_tree
+		class tree_index {
+		public:
+			using const_iterator = typename detail::btree<edge>::iterator;
+			using position = const_iterator;
+
+			explicit tree_index(storage const* s)
+			: s_{s}
+			, edges_{s->arena}
+			, in_edges_{s->arena} {}
+
+			tree_index(storage const* s, tree_index const& other)
+			: s_{s}
+			, edges_{other.edges_}
+			, in_edges_{other.in_edges_} {}
+
+			[[nodiscard]] auto begin() const -> const_iterator {
+				return edges_.begin();
+			}
+
+			[[nodiscard]] auto end() const -> const_iterator {
+				return edges_.end();
+			}
+
+			[[nodiscard]] auto size() const noexcept -> std::size_t {
+				return edges_.size();
+			}
+
+			[[nodiscard]] auto less(edge const& x, edge const& y) const -> bool {
+				return edge_cmp{s_}(x, y);
+			}
+
+			[[nodiscard]] auto find(edge const& key) const -> const_iterator {
+				return edges_.find(s_->key_ref(key), edge_cmp{s_});
+			}
+
+			[[nodiscard]] auto lower_bound(edge const& key) const -> position {
+				return edges_.lower_bound(s_->key_ref(key), edge_cmp{s_});
+			}
+
+			// For keys in ascending order: hint is the lower bound of the previous key, so it is
+			// still the lower bound unless key is past it.
+			[[nodiscard]] auto lower_bound(position hint, edge const& key) const -> position {
+				return hint == edges_.end() or less(key, *hint) ? hint : lower_bound(key);
+			}
+
+			// Whether key is the edge at its lower bound pos.
+			[[nodiscard]] auto holds(position pos, edge const& key) const -> bool {
+				return pos != edges_.end() and not less(key, *pos);
+			}
+
+			[[nodiscard]] auto contains(node_id src, node_id dst) const -> bool {
+				return edges_.contains(src_dst_key{s_->ref(src), s_->ref(dst)}, edge_cmp{s_});
+			}
+
+			[[nodiscard]] auto out_range(node_id src) const {
+				return edges_.equal_range(src_key{s_->ref(src)}, edge_cmp{s_});
+			}
+
+			[[nodiscard]] auto out_range(node_id src, node_id dst) const {
+				return edges_.equal_range(src_dst_key{s_->ref(src), s_->ref(dst)}, edge_cmp{s_});
+			}
+
+			// The sources of the edges entering dst, one for each edge.
+			[[nodiscard]] auto in_range(node_id dst) const {
+				auto const [first, last] =
+				   in_edges_.equal_range(dst_key{s_->ref(dst)}, in_edge_cmp{s_});
+				return std::ranges::subrange(first, last)
+				       | std::views::transform([](in_entry const& e) { return e.src; });
+			}
+
+			// Adds e, whose lower bound is pos, both ways and returns where it went. Adds nothing
+			// if this throws.
+			auto insert(position pos, edge const& e, std::uint64_t serial) -> position {
+				auto stamped = e;
+				stamped.serial = serial;
+				// The reverse entry goes in first, as taking an edge back out can throw while taking
+				// an entry out can't.
+				auto const entry = in_entry{e.dst, e.src};
+				auto const key = in_key{s_->ref(e.dst), s_->ref(e.src)};
+				auto const in_it = in_edges_.insert(in_edges_.upper_bound(key, in_edge_cmp{s_}),
+				                                    entry);
+				try {
+					return edges_.insert(pos, std::move(stamped));
+				} catch (...) {
+					in_edges_.erase(in_it);
+					throw;
+				}
+			}
+
+			// Erases nothing if this throws. The edge goes first, as only it can throw; with the
+			// entry's path owned beforehand, taking the entry out can't.
+			auto erase(const_iterator it) -> const_iterator {
+				auto const rank = it.index();
+				auto const in_rank =
+				   in_edges_.lower_bound(in_key{s_->ref(it->dst), s_->ref(it->src)}, in_edge_cmp{s_})
+				      .index();
+				in_edges_.own(in_rank);
+				edges_.erase(rank);
+				in_edges_.erase(in_rank);
+				return edges_.at(rank);
+			}
+
+			// e goes after every edge so far.
+			auto append_out(edge const& e) -> void {
+				edges_.push_back(e);
+			}
+
+			// Fills the empty reverse index from the edge set. A stable counting sort on the rank
+			// of dst puts the edges in (dst, src) order without comparing any values, so each goes
+			// in at the end.
+			auto append_in() -> void {
+				assert(in_edges_.empty());
+				auto rank = std::vector<std::uint32_t>(s_->id_bound);
+				auto next_rank = std::uint32_t{0};
+				for (auto const id : s_->nodes) {
+					rank[id_index(id)] = next_rank++;
+				}
+				auto starts = std::vector<std::size_t>(s_->nodes.size() + 1, 0);
+				for (auto const& e : edges_) {
+					++starts[rank[id_index(e.dst)] + 1];
+				}
+				std::partial_sum(starts.begin(), starts.end(), starts.begin());
+				auto by_dst = std::vector<in_entry>(edges_.size());
+				for (auto const& e : edges_) {
+					by_dst[starts[rank[id_index(e.dst)]]++] = in_entry{e.dst, e.src};
+				}
+				for (auto const& entry : by_dst) {
+					in_edges_.push_back(entry);
+				}
+			}
+
+		private:
+			storage const* s_;
+			detail::btree<edge> edges_;
+			detail::btree<in_entry> in_edges_;
+		};
+
+		// layout::adjacency. Every node has its own trees, in a table indexed by node id that
+		// copies of the storage share too, so copying a node's edges on write only copies the
+		// chunk of the table it is in. A node's first few edges each way are kept in its entry,
+		// and only a node with more has trees of its own. Iteration walks the node tree, in
+		// order, through each node's outgoing edges.
+		class adjacency_index {
+			struct node_edges {
+				detail::small_tree<edge> out;
+				// The sources of the incoming edges, one for each edge.
+				detail::small_tree<node_id> in;
+			};
+
+			using out_iterator = typename detail::small_tree<edge>::iterator;
+
+		public:
+			class const_iterator {
+			public:
+				using value_type = edge;
+				using reference = edge const&;
+				using pointer = edge const*;
+				using difference_type = std::ptrdiff_t;
+				using iterator_category = std::bidirectional_iterator_tag;
+
+				const_iterator() = default;
+
+				auto operator*() const -> edge const& {
+					return *edge_;
+				}
+
+				auto operator->() const -> edge const* {
+					return &*edge_;
+				}
+
+				auto operator++() -> const_iterator& {
+					++edge_;
+					skip_empty();
+					return *this;
+				}
+
+				auto operator++(int) -> const_iterator {
+					auto old = *this;
+					++(*this);
+					return old;
+				}
+
+				auto operator--() -> const_iterator& {
+					while (node_ == index_->s_->nodes.end() or edge_ == index_->out(*node_).begin()) {
+						--node_;
+						edge_ = index_->out(*node_).end();
+					}
+					--edge_;
+					return *this;
+				}
+
+				auto operator--(int) -> const_iterator {
+					auto old = *this;
+					--(*this);
+					return old;
+				}
+
+				// end() holds a value-initialised edge_, so that comparing edge_ is enough.
+				auto operator==(const_iterator const& other) const -> bool {
+					return node_ == other.node_ and edge_ == other.edge_;
+				}
+
+			private:
+				friend class adjacency_index;
+
+				adjacency_index const* index_ = nullptr;
+				typename node_tree::iterator node_;
+				out_iterator edge_;
+
+				const_iterator(adjacency_index const* index,
+				               typename node_tree::iterator node,
+				               out_iterator e)
+				: index_{index}
+				, node_{node}
+				, edge_{e} {
+					skip_empty();
+				}
+
+				// Moves off the end of a node's edges to the first edge of the next node with any.
+				auto skip_empty() -> void {
+					auto const& nodes = index_->s_->nodes;
+					while (node_ != nodes.end() and edge_.at_end()) {
+						++node_;
+						edge_ = node_ == nodes.end() ? out_iterator{} : index_->out(*node_).begin();
+					}
+				}
+			};
+
+			using position = out_iterator;
+
+			explicit adjacency_index(storage const* s)
+			: s_{s}
+			, sets_{s->arena} {}
+
+			adjacency_index(storage const* s, adjacency_index const& other)
+			: s_{s}
+			, sets_{other.sets_}
+			, size_{other.size_} {}
+
+			[[nodiscard]] auto begin() const -> const_iterator {
+				auto const first = s_->nodes.begin();
+				if (first == s_->nodes.end()) {
+					return end();
+				}
+				return const_iterator{this, first, out(*first).begin()};
+			}
+
+			[[nodiscard]] auto end() const -> const_iterator {
+				return const_iterator{this, s_->nodes.end(), {}};
+			}
+
+			[[nodiscard]] auto size() const noexcept -> std::size_t {
+				return size_;
+			}
+
+			[[nodiscard]] auto less(edge const& x, edge const& y) const -> bool {
+				return edge_cmp{s_}(x, y);
+			}
+
+			[[nodiscard]] auto find(edge const& key) const -> const_iterator {
+				auto const& edges = out(key.src);
+				auto const it = edges.find(s_->key_ref(key), edge_cmp{s_});
+				if (it == edges.end()) {
+					return end();
+				}
+				return const_iterator{this, s_->nodes.find(s_->ref(key.src), node_cmp{s_}), it};
+			}
+
+			[[nodiscard]] auto lower_bound(edge const& key) const -> position {
+				return out(key.src).lower_bound(s_->key_ref(key), edge_cmp{s_});
+			}
+
+			// A node's own tree is small enough to search again.
+			[[nodiscard]] auto lower_bound(position, edge const& key) const -> position {
+				return lower_bound(key);
+			}
+
+			[[nodiscard]] auto holds(position pos, edge const& key) const -> bool {
+				return pos != out(key.src).end() and not less(key, *pos);
+			}
+
+			[[nodiscard]] auto contains(node_id src, node_id dst) const -> bool {
+				return out(src).contains(src_dst_key{s_->ref(src), s_->ref(dst)}, edge_cmp{s_});
+			}
+
+			[[nodiscard]] auto out_range(node_id src) const {
+				auto const& edges = out(src);
+				return std::pair{edges.begin(), edges.end()};
+			}
+
+			[[nodiscard]] auto out_range(node_id src, node_id dst) const {
+				return out(src).equal_range(src_dst_key{s_->ref(src), s_->ref(dst)}, edge_cmp{s_});
+			}
+
+			[[nodiscard]] auto in_range(node_id dst) const {
+				auto const& in = sets_[id_index(dst)].in;
+				return std::ranges::subrange(in.begin(), in.end());
+			}
+
+			// Both nodes' entries are written before either tree changes, so that the first
+			// reference stays valid.
+			auto insert(position pos, edge const& e, std::uint64_t serial) -> position {
+				auto& to = sets_.write(id_index(e.dst));
+				auto& from = sets_.write(id_index(e.src));
+				auto stamped = e;
+				stamped.serial = serial;
+				auto const in_it = to.in.insert(to.in.upper_bound(s_->ref(e.src), node_cmp{s_}),
+				                                e.src,
+				                                s_->arena);
+				auto it = position{};
+				try {
+					it = from.out.insert(pos, std::move(stamped), s_->arena);
+				} catch (...) {
+					to.in.erase(in_it);
+					throw;
+				}
+				++size_;
+				return it;
+			}
+
+			// As for tree_index.
+			auto erase(const_iterator it) -> const_iterator {
+				auto const src = it->src;
+				auto const dst = it->dst;
+				auto const rank = it.edge_.index();
+				auto& to = sets_.write(id_index(dst));
+				auto& from = sets_.write(id_index(src));
+				auto const in_rank = to.in.lower_bound(s_->ref(src), node_cmp{s_}).index();
+				to.in.own(in_rank);
+				from.out.erase(rank);
+				to.in.erase(in_rank);
+				--size_;
+				return const_iterator{this, it.node_, from.out.at(rank)};
+			}
+
+			auto append_out(edge const& e) -> void {
+				sets_.write(id_index(e.src)).out.push_back(e, s_->arena);
+				++size_;
+			}
+
+			// In outgoing order each node's incoming edges come up by src, which is the order of
+			// its incoming tree, so each goes in at the end.
+			auto append_in() -> void {
+				for (auto const& e : *this) {
+					sets_.write(id_index(e.dst)).in.push_back(e.src, s_->arena);
+				}
+			}
+
+		private:
+			storage const* s_;
+			detail::radix_table<node_edges> sets_;
+			std::size_t size_ = 0;
+
+			[[nodiscard]] auto out(node_id id) const -> detail::small_tree<edge> const& {
+				return sets_[id_index(id)].out;
+			}
+		};
+
+		static_assert(std::is_same_v<edge_layout, layout::edge_tree>
+		                 or std::is_same_v<edge_layout, layout::adjacency>,
+		              "Layout must be one of the tags in gdwg::layout");
+		using edge_index = std::
+		   conditional_t<std::is_same_v<edge_layout, layout::adjacency>, adjacency_index, tree_index>;
+
+		// Everything a graph holds. The node table and the trees are made of reference-counted
+		// chunks that copies share, so copying a storage is O(1) and each modifier copies only
+		// the chunks it changes that another storage also holds. The edge comparators and
+		// iterators reach node values through the storage, so it never moves: it lives on the
+		// heap, shared between copies of a graph.
+		struct storage {
+			// Where the trees get their nodes. Copies share it.
+			detail::node_arena arena;
+			detail::radix_table<node_slot> by_id;
+			// Every id handed out so far is less than this.
+			std::size_t id_bound = 0;
+			// The most recently freed id, which heads a list through node_slot::next_free.
+			node_id free_id = no_id;
+			// Node ids in order of their nodes' values.
+			node_tree nodes;
+			edge_index edges;
+			// With an interned layout, every distinct weight, referenced once by each edge that
+			// has it.
+			[[no_unique_address]] std::
+			   conditional_t<interned_weights, detail::intern_table<E>, std::monostate> weights;
+			// Sum of node_record::hash over the nodes and edge_hash() over the edges.
+			std::uint64_t fingerprint = 0;
+			// The serial of the edge taken in last.
+			std::uint64_t last_serial = 0;
+
+			storage()
+			: arena{detail::node_arena::make()}
+			, by_id{arena}
+			, nodes{arena}
+			, edges(this)
+			, weights{make_weights(arena)} {}
+
+			// Shares everything with other. O(1)
+			explicit storage(storage const& other)
+			: arena{other.arena}
+			, by_id{other.by_id}
+			, id_bound{other.id_bound}
+			, free_id{other.free_id}
+			, nodes{other.nodes}
+			, edges(this, other.edges)
+			, weights{other.weights}
+			, fingerprint{other.fingerprint}
+			, last_serial{other.last_serial} {}
+
+			storage(storage&&) = delete;
+			auto operator=(storage const&) -> storage& = delete;
+			auto operator=(storage&&) -> storage& = delete;
+			~storage() = default;
+
+			[[nodiscard]] static auto make_weights(detail::node_arena const& arena) noexcept {
+				if constexpr (interned_weights) {
+					return detail::intern_table<E>{arena};
+				}
+				else {
+					return std::monostate{};
+				}
+			}
+
+			[[nodiscard]] auto value(node_id id) const -> N const& {
+				return by_id[id_index(id)].node->value;
+			}
+
+			[[nodiscard]] auto ref(node_id id) const -> node_ref {
+				return node_ref{id, &value(id)};
+			}
+
+			[[nodiscard]] auto key_ref(edge const& e) const -> edge_key_ref {
+				return edge_key_ref{ref(e.src), ref(e.dst), &e.weight};
+			}
+
+			// Nodes are unique, so N only has to be compared when the ids differ.
+			[[nodiscard]] auto less(node_id x, node_id y) const -> bool {
+				return x != y and value(x) < value(y);
+			}
+
+			[[nodiscard]] auto less(node_id x, node_ref const& y) const -> bool {
+				return x != y.id and value(x) < *y.value;
+			}
+
+			[[nodiscard]] auto less(node_ref const& x, node_id y) const -> bool {
+				return x.id != y and *x.value < value(y);
+			}
+
+			// Built from the endpoints' hashes, which are already stored, so only the weight is
+			// hashed. Mixed in two steps so that reversing an edge changes its hash.
+			[[nodiscard]] auto edge_hash(edge const& e) const noexcept -> std::uint64_t {
+				auto const src_hash = by_id[id_index(e.src)].node->hash;
+				auto const dst_hash = by_id[id_index(e.dst)].node->hash;
+				return detail::mix(src_hash + detail::mix(dst_hash ^ detail::hash_of(weight(e))));
+			}
+
+			[[nodiscard]] auto weight(edge const& e) const noexcept -> E const& {
+				if constexpr (interned_weights) {
+					return weights[e.weight];
+				}
+				else {
+					return e.weight;
+				}
+			}
+
+			// Interned weights are distinct, so E only has to be compared when the handles differ.
+			[[nodiscard]] auto less_weight(weight_ref const& x, weight_ref const& y) const -> bool {
+				if constexpr (interned_weights) {
+					return x != y and weights[x] < weights[y];
+				}
+				else {
+					return x < y;
+				}
+			}
+
+			// The edge as the index holds it. An interned weight that no edge has yet is added
+			// without references: the edge must go in straight away, or the key be held through
+			// an edge_key, which drops the weight again if no edge goes in.
+			auto make_edge(node_id src, node_id dst, E const& w) -> edge {
+				if constexpr (interned_weights) {
+					return edge{src, dst, weights.intern(w)};
+				}
+				else {
+					return edge{src, dst, w};
+				}
+			}
+
+			// A key from make_edge that holds a reference to its interned weight until it goes out
+			// of scope, so a weight interned for an insertion that throws or adds nothing doesn't
+			// stay in the table.
+			class edge_key {
+			public:
+				edge_key(storage& s, node_id src, node_id dst, E const& w)
+				: s_{s}
+				, key_{s.make_edge(src, dst, w)} {
+					if constexpr (interned_weights) {
+						s_.weights.acquire(key_.weight);
+					}
+				}
+
+				edge_key(edge_key const&) = delete;
+				auto operator=(edge_key const&) -> edge_key& = delete;
+
+				~edge_key() {
+					if constexpr (interned_weights) {
+						s_.weights.release(key_.weight);
+					}
+				}
+
+				[[nodiscard]] auto get() const noexcept -> edge const& {
+					return key_;
+				}
+
+			private:
+				storage& s_;
+				edge key_;
+			};
+
+			// The same for a search, which adds nothing: empty if no edge has weight w.
+			[[nodiscard]] auto find_edge_key(node_id src, node_id dst, E const& w) const
+			   -> std::optional<edge> {
+				if constexpr (interned_weights) {
+					auto const handle = weights.find(w);
+					if (not handle) {
+						return std::nullopt;
+					}
+					return edge{src, dst, *handle};
+				}
+				else {
+					return edge{src, dst, w};
+				}
+			}
+
+			// Gives the new node the most recently freed id, or a fresh one past the end if none is
+			// free, and puts it at pos, its lower bound in the node tree.
+			auto emplace_node(typename node_tree::iterator pos, N const& v) ->
+			   typename node_tree::iterator {
+				auto const id = free_id != no_id ? free_id : static_cast<node_id>(id_bound);
+				assert(free_id != no_id or id_bound < std::numeric_limits<std::uint32_t>::max());
+				auto& slot = by_id.write(id_index(id));
+				slot.node.emplace(node_record{v, id, detail::hash_of(v)});
+				auto it = typename node_tree::iterator{};
+				try {
+					it = nodes.insert(pos, id);
+				} catch (...) {
+					slot.node.reset();
+					throw;
+				}
+				if (id == free_id) {
+					free_id = slot.next_free;
+				}
+				else {
+					++id_bound;
+				}
+				fingerprint += slot.node->hash;
+				return it;
+			}
+
+			// The node must have no edges.
+			auto erase_node(node_id id) -> void {
+				auto const it = nodes.find(ref(id), node_cmp{this});
+				auto& slot = by_id.write(id_index(id));
+				nodes.erase(it);
+				fingerprint -= slot.node->hash;
+				slot.node.reset();
+				slot.next_free = free_id;
+				free_id = id;
+			}
+
+			// Every edge in the index holds one reference to its interned weight. Adds e, whose
+			// lower bound in the index is pos, and returns where it went; adds nothing if this
+			// throws.
+			auto insert_edge_at(typename edge_index::position pos, edge const& e) ->
+			   typename edge_index::position {
+				if constexpr (interned_weights) {
+					weights.acquire(e.weight);
+					try {
+						pos = edges.insert(pos, e, last_serial + 1);
+					} catch (...) {
+						weights.release(e.weight);
+						throw;
+					}
+				}
+				else {
+					pos = edges.insert(pos, e, last_serial + 1);
+				}
+				++last_serial;
+				fingerprint += edge_hash(e);
+				return pos;
+			}
+
+			// Returns false, changing nothing, if the edge already exists.
+			auto insert_edge_record(edge const& e) -> bool {
+				auto const pos = edges.lower_bound(e);
+				if (edges.holds(pos, e)) {
+					return false;
+				}
+				insert_edge_at(pos, e);
+				return true;
+			}
+
+			auto erase_edge_at(typename edge_index::const_iterator it) ->
+			   typename edge_index::const_iterator {
+				auto const hash = edge_hash(*it);
+				if constexpr (interned_weights) {
+					auto const handle = it->weight;
+					weights.own(handle);
+					auto const next = edges.erase(it);
+					weights.release(handle);
+					fingerprint -= hash;
+					return next;
+				}
+				else {
+					auto const next = edges.erase(it);
+					fingerprint -= hash;
+					return next;
+				}
+			}
+
+			// Does nothing if there is no such edge.
+			auto erase_edge(edge const& key) -> void {
+				auto const it = edges.find(key);
+				if (it != edges.end()) {
+					erase_edge_at(it);
+				}
+			}
+
+			// Fills an edgeless storage from distinct edges given in (src, dst, weight) order, so
+			// each goes in at the end without searching. If this throws, the storage must be
+			// thrown away, as the two directions of the index may differ.
+			auto append_edges(std::vector<edge_value> const& sorted) -> void {
+				assert(edges.size() == 0);
+				for (auto const& value : sorted) {
+					auto e = make_edge(value.src, value.dst, value.weight);
+					e.serial = ++last_serial;
+					if constexpr (interned_weights) {
+						weights.acquire(e.weight);
+					}
+					edges.append_out(e);
+					fingerprint += edge_hash(e);
+				}
+				edges.append_in();
+			}
+
+			// Edges leaving or entering id, each listed once (self-loops come from the out range).
+			// The reverse index gives each edge's source, and the edges from a source are found
+			// in the edge set once per source.
+			auto incident_edges(node_id id) const -> std::vector<edge> {
+				auto const [out_first, out_last] = edges.out_range(id);
+				auto v = std::vector<edge>(out_first, out_last);
+				auto previous = std::optional<node_id>{};
+				for (auto const src : edges.in_range(id)) {
+					if (src != id and src != previous) {
+						auto const [first, last] = edges.out_range(src, id);
+						v.insert(v.end(), first, last);
+					}
+					previous = src;
+				}
+				return v;
+			}
+		};
+
+		// Created on the first insertion so that default construction and moves stay noexcept.
+		std::shared_ptr<storage> storage_;
+
+		// What the accessors read: storage_, or an empty storage if there is none yet.
+		[[nodiscard]] auto state() const noexcept -> storage const& {
+			static storage const empty;
+			return storage_ != nullptr ? *storage_ : empty;
+		}
+
+		// Whether own_state() would copy the storage. Modifiers on a shared graph first make sure
+		// they will change something, so that a call that changes nothing doesn't copy.
+		[[nodiscard]] auto shared() const noexcept -> bool {
+			return storage_ != nullptr and storage_.use_count() > 1;
+		}
+
+		// What the modifiers write: storage_, created if there is none yet and copied if another
+		// graph shares it. Ids survive the copy; pointers and iterators into the old storage don't.
+		auto own_state() -> storage& {
+			if (storage_ == nullptr) {
+				storage_ = std::make_shared<storage>();
+			}
+			else if (storage_.use_count() > 1) {
+				storage_ = std::make_shared<storage>(*storage_);
+			}
+			else {
+				// Any other owner has let go, with a release decrement; see all that it did.
+				std::atomic_thread_fence(std::memory_order_acquire);
+			}
+			return *storage_;
+		}
+
+		// own_state(), moving it along to the same edge (or end()) if the storage gets copied.
+		auto own_edge(typename edge_index::const_iterator& it) -> void {
+			own_edges(it, it);
+		}
+
+		auto own_edges(typename edge_index::const_iterator& first,
+		               typename edge_index::const_iterator& last) -> void {
+			if (storage_ == nullptr or storage_.use_count() == 1) {
+				own_state();
+				return;
+			}
+			auto const& old = storage_->edges;
+			auto const first_key = first == old.end() ? std::nullopt : std::optional<edge>(*first);
+			auto const last_key = last == old.end() ? std::nullopt : std::optional<edge>(*last);
+			auto const& edges = own_state().edges;
+			first = first_key ? edges.find(*first_key) : edges.end();
+			last = last_key ? edges.find(*last_key) : edges.end();
+		}
+
+		[[nodiscard]] auto find_node(N const& value) const -> node_record const* {
+			auto const& s = state();
+			auto const it = s.nodes.find(value, node_cmp{&s});
+			return it == s.nodes.end() ? nullptr : &*s.by_id[id_index(*it)].node;
+		}
+
+		[[nodiscard]] auto has_edge(node_id src, node_id dst, E const& weight) const -> bool {
+			auto const& s = state();
+			auto const key = s.find_edge_key(src, dst, weight);
+			return key and s.edges.find(*key) != s.edges.end();
+		}
+
+		[[nodiscard]] auto make_iterator(typename edge_index::const_iterator it) const -> iterator {
+			return iterator{&state(), it};
+		}
+
+		auto weights_of(node_id src, node_id dst) const -> std::vector<E> {
+			auto const& s = state();
+			auto const [first, last] = s.edges.out_range(src, dst);
+			auto v = std::vector<E>{};
+			std::transform(first, last, std::back_inserter(v), [&s](edge const& e) {
+				return s.weight(e);
+			});
+			return v;
+		}
 
 		// Hidden Friend: Extractor
+		// n + e: the edge set is sorted by source in node order, so one pass over it, in step with
+		// the nodes, finds every node's edges.
 		friend auto operator<<(std::ostream& os, graph const& g) -> std::ostream& {
-			for (auto const& node_it : g.nodes_)   {
-				os << *node_it << " (\n";
-				for (auto const& edge_it : g.edges_) {
-					if (*(edge_it->src) == *node_it) {
-						os << "  " << *(edge_it->dst) << " | " << edge_it->weight << "\n";
-					}
+			auto const& s = g.state();
+			auto out = detail::text_sink(os);
+			auto edge_it = s.edges.begin();
+			for (auto const id : s.nodes) {
+				out.put(s.value(id));
+				out.put(" (\n");
+				for (; edge_it != s.edges.end() and edge_it->src == id; ++edge_it) {
+					out.put("  ");
+					out.put(s.value(edge_it->dst));
+					out.put(" | ");
+					out.put(s.weight(*edge_it));
+					out.put("\n");
 				}
-				os << ")\n";
+				out.put(")\n");
 			}
+			out.flush();
 			return os;
 		}
 
 	public:
 		class iterator {
 		public:
-			using value_type = graph<N, E>::value_type;
-			using reference = value_type;
+			using value_type = graph::value_type;
+			using reference = graph::reference;
 			using pointer = void;
 			using difference_type = std::ptrdiff_t;
 			using iterator_category = std::bidirectional_iterator_tag;
@@ -389,12 +1880,14 @@ namespace gdwg {
 
 			// Iterator source
 			auto operator*() const -> reference {
-				return value_type{*((*iter_)->src), *((*iter_)->dst), (*iter_)->weight};
+				auto const& e = *iter_;
+				return reference{storage_->value(e.src), storage_->value(e.dst), storage_->weight(e)};
 			}
 
 			// Iterator traversal
 			auto operator++() -> iterator& {
 				++iter_;
+				serial_ = serial_of(storage_, iter_);
 				return *this;
 			}
 
@@ -406,6 +1899,7 @@ namespace gdwg {
 
 			auto operator--() -> iterator& {
 				--iter_;
+				serial_ = serial_of(storage_, iter_);
 				return *this;
 			}
 
@@ -417,20 +1911,30 @@ namespace gdwg {
 
 			// Iterator comparison
 			auto operator==(iterator const& other) const -> bool {
-				return iter_ == other.iter_;
+				return storage_ == other.storage_ and serial_ == other.serial_;
 			}
 
 		private:
-			friend class graph<N, E>;
-			using edges_iterator = typename std::set<std::shared_ptr<edge>, edge_cmp>::iterator;
+			friend class graph;
+			using edges_iterator = typename edge_index::const_iterator;
 
+			storage const* storage_ = nullptr;
 			edges_iterator iter_;
+			// The edge's serial, or 0 at the end. Erasing an edge moves the later edges in the
+			// index, so it is the serial rather than iter_ that says which edge this is.
+			std::uint64_t serial_ = 0;
+
+			iterator(storage const* s, edges_iterator it)
+			: storage_{s}
+			, iter_{it}
+			, serial_{serial_of(s, it)} {}
 
-			explicit iterator(edges_iterator begin)
-			: iter_{begin} {}
+			static auto serial_of(storage const* s, edges_iterator it) -> std::uint64_t {
+				return it == s->edges.end() ? 0 : it->serial;
+			}
 
 		};
 	};
 } // namespace gdwg
 
-#endif // GDWG_GRAPH_HPP
\ No newline at end of file
+#endif // GDWG_GRAPH_HPP
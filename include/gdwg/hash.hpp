@@ -0,0 +1,38 @@
+#ifndef GDWG_HASH_HPP
+#define GDWG_HASH_HPP
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace gdwg::detail {
+	template<typename T>
+	concept hashable = requires(T const& value) {
+		{ std::hash<T>{}(value) } -> std::convertible_to<std::size_t>;
+	};
+
+	// splitmix64's finaliser. std::hash is often the identity on integers, so anything that sums
+	// or buckets hashes runs them through this first.
+	constexpr auto mix(std::uint64_t x) noexcept -> std::uint64_t {
+		x ^= x >> 30;
+		x *= 0xbf58476d1ce4e5b9ULL;
+		x ^= x >> 27;
+		x *= 0x94d049bb133111ebULL;
+		x ^= x >> 31;
+		return x;
+	}
+
+	// Mixed std::hash of value, or 0 for types std::hash doesn't support.
+	template<typename T>
+	auto hash_of(T const& value) noexcept -> std::uint64_t {
+		if constexpr (hashable<T>) {
+			return mix(static_cast<std::uint64_t>(std::hash<T>{}(value)));
+		}
+		else {
+			return 0;
+		}
+	}
+} // namespace gdwg::detail
+
+#endif // GDWG_HASH_HPP
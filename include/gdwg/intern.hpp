@@ -0,0 +1,153 @@
+#ifndef GDWG_INTERN_HPP
+#define GDWG_INTERN_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+
+#include "gdwg/btree.hpp"
+#include "gdwg/radix_table.hpp"
+
+namespace gdwg::detail {
+	// Keeps one copy of each distinct value, named by a 32-bit handle. Every holder of a handle
+	// counts as one reference: acquire() and release() keep the count, and the value is dropped
+	// and its handle reused once the last reference goes. A copy gives every value the same
+	// handle it had in the original, so handles held elsewhere can be copied along with it. Copies
+	// share the values and counts until one of them changes, as the tables they live in do.
+	template<typename T>
+	class intern_table {
+	public:
+		using handle = std::uint32_t;
+
+		intern_table() noexcept = default;
+
+		// Takes the nodes of its trees from arena.
+		explicit intern_table(node_arena const& arena) noexcept
+		: slots_{arena}
+		, order_{arena} {}
+
+		// The handle of value, if it is held.
+		[[nodiscard]] auto find(T const& value) const -> std::optional<handle> {
+			auto const it = order_.find(value, by_value{this});
+			if (it == order_.end()) {
+				return std::nullopt;
+			}
+			return *it;
+		}
+
+		// The handle of value, adding it without any references if it isn't held. Such a value
+		// stays until trim() or clear() if nothing acquires it.
+		auto intern(T const& value) -> handle {
+			auto const pos = order_.lower_bound(value, by_value{this});
+			if (pos != order_.end() and not(value < (*this)[*pos])) {
+				return *pos;
+			}
+			auto const id = free_ != none ? free_ : bound_;
+			assert(id < none);
+			auto& slot = slots_.write(id);
+			auto const next_free = slot.next_free;
+			slot.value.emplace(value);
+			try {
+				order_.insert(pos, id);
+			} catch (...) {
+				slot.value.reset();
+				throw;
+			}
+			slot.refs = 0;
+			slot.next_free = none;
+			if (id == bound_) {
+				++bound_;
+			}
+			else {
+				free_ = next_free;
+			}
+			return id;
+		}
+
+		auto acquire(handle h) -> void {
+			++slots_.write(h).refs;
+		}
+
+		// Makes h's count this table's own, so that release(h) can't fail. acquire(h) does the
+		// same until the table is next copied.
+		auto own(handle h) -> void {
+			slots_.write(h);
+		}
+
+		auto release(handle h) noexcept -> void {
+			auto& slot = slots_.write(h);
+			assert(slot.refs > 0);
+			--slot.refs;
+			trim(h);
+		}
+
+		// Drops the value behind h if nothing holds it; h must be owned as for release(). Finding
+		// its place in the order compares values, and if that throws the value stays, without
+		// references, for intern() to find again.
+		auto trim(handle h) noexcept -> void {
+			auto& slot = slots_.write(h);
+			if (slot.refs != 0) {
+				return;
+			}
+			try {
+				auto const pos = order_.find(*slot.value, by_value{this});
+				assert(pos != order_.end() and *pos == h);
+				order_.erase(pos);
+			} catch (...) {
+				return;
+			}
+			slot.value.reset();
+			slot.next_free = free_;
+			free_ = h;
+		}
+
+		[[nodiscard]] auto operator[](handle h) const noexcept -> T const& {
+			return *slots_[h].value;
+		}
+
+		// Number of distinct values held.
+		[[nodiscard]] auto size() const noexcept -> std::size_t {
+			return order_.size();
+		}
+
+		auto clear() noexcept -> void {
+			slots_.clear();
+			order_.clear();
+			free_ = none;
+			bound_ = 0;
+		}
+
+	private:
+		static constexpr auto none = std::numeric_limits<handle>::max();
+
+		// A live handle has its value; a free one links to the next free handle.
+		struct slot {
+			std::optional<T> value;
+			std::uint32_t refs = 0;
+			handle next_free = none;
+		};
+
+		// Orders handles by their values.
+		struct by_value {
+			intern_table const* table;
+
+			auto operator()(handle x, T const& y) const -> bool {
+				return (*table)[x] < y;
+			}
+
+			auto operator()(T const& x, handle y) const -> bool {
+				return x < (*table)[y];
+			}
+		};
+
+		radix_table<slot> slots_;
+		btree<handle> order_;
+		handle free_ = none;
+		// Every handle handed out so far is below this.
+		handle bound_ = 0;
+	};
+} // namespace gdwg::detail
+
+#endif // GDWG_INTERN_HPP
@@ -0,0 +1,46 @@
+#ifndef GDWG_LAYOUT_HPP
+#define GDWG_LAYOUT_HPP
+
+namespace gdwg {
+	// How a graph keeps its edges, picked by its third template parameter. Every layout offers
+	// the same interface, orders everything the same way and gives the same results; they differ
+	// in what each operation costs.
+	namespace layout {
+		// One tree of all the edges ordered by (src, dst, weight) and one of their endpoints
+		// ordered by (dst, src). Finding a node's edges is a search of every edge in the graph,
+		// but iteration never has to skip anything.
+		struct edge_tree {};
+
+		// Every node has its own tree of outgoing edges ordered by (dst, weight) and of the
+		// sources of its incoming edges, so finding a node's edges only searches those. The first
+		// few edges each way are kept in the node's entry, so a node with few edges allocates
+		// nothing for them. Iteration walks the nodes and skips those without outgoing edges.
+		struct adjacency {};
+
+		// Edges kept as in Base, but each distinct weight is stored once and edges hold a 32-bit
+		// handle to it. Pays off for large weights with few distinct values, such as string
+		// labels; comparing two different weights follows their handles.
+		template<typename Base = edge_tree>
+		struct interned {};
+	} // namespace layout
+
+	namespace detail {
+		// Splits a layout into its edge index and whether weights are interned.
+		template<typename Layout>
+		struct layout_traits {
+			using edges = Layout;
+			static constexpr bool interned = false;
+		};
+
+		template<typename Base>
+		struct layout_traits<layout::interned<Base>> {
+			using edges = Base;
+			static constexpr bool interned = true;
+		};
+	} // namespace detail
+
+	template<typename N, typename E, typename Layout = layout::edge_tree>
+	class graph;
+} // namespace gdwg
+
+#endif // GDWG_LAYOUT_HPP
@@ -0,0 +1,314 @@
+#ifndef GDWG_MAPPED_GRAPH_HPP
+#define GDWG_MAPPED_GRAPH_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <iterator>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "gdwg/csr_view.hpp"
+#include "gdwg/frozen_graph.hpp"
+
+namespace gdwg {
+	// Read-only graph queried straight out of a memory-mapped file, so opening one builds
+	// nothing in memory however big the graph is; pages are read in as they are touched. The file
+	// holds the same compressed sparse row arrays as a frozen_graph, written by write() in the
+	// machine's own layout at offsets from the start of the file, so nothing needs fixing up
+	// after mapping. That needs fixed-size N and E, and files only open on machines with the same
+	// byte order and type sizes as the writer. The queries are csr_view's, over the mapping.
+	//
+	// Opening is O(1): it checks the header and that every array lies inside the mapping, and
+	// reads nothing else, so pages are only read in as queries touch them. The offsets and targets
+	// are trusted, so a corrupt file can make a query read outside the mapping. A file that may be
+	// corrupt should be checked with verify() before it is queried.
+	template<typename N, typename E>
+	requires std::is_trivially_copyable_v<N> and std::is_trivially_copyable_v<E>
+	class mapped_graph {
+		using view_type = detail::csr_view<N, E, std::uint64_t>;
+
+	public:
+		using value_type = typename view_type::value_type;
+		using reference = typename view_type::reference;
+		using index_type = typename view_type::index_type;
+		using iterator = typename view_type::iterator;
+
+		// Writes g in the layout the constructor maps.
+		static auto write(frozen_graph<N, E> const& g, std::ostream& os) -> void {
+			auto h = header{};
+			std::memcpy(h.magic, file_magic, sizeof(file_magic));
+			h.version = file_version;
+			h.byte_order = byte_order_mark;
+			h.node_size = sizeof(N);
+			h.weight_size = sizeof(E);
+			h.num_nodes = g.num_nodes();
+			h.num_edges = g.num_edges();
+			h.nodes_at = align(sizeof(header));
+			h.offsets_at = align(h.nodes_at + h.num_nodes * sizeof(N));
+			h.targets_at = align(h.offsets_at + (h.num_nodes + 1) * sizeof(std::uint64_t));
+			h.weights_at = align(h.targets_at + h.num_edges * sizeof(index_type));
+			h.file_size = h.weights_at + h.num_edges * sizeof(E);
+
+			auto at = std::uint64_t{0};
+			auto const put = [&os, &at](void const* data, std::uint64_t size) {
+				os.write(static_cast<char const*>(data), static_cast<std::streamsize>(size));
+				at += size;
+			};
+			auto const pad_to = [&put, &at](std::uint64_t offset) {
+				static constexpr char zeros[section_alignment] = {};
+				put(zeros, offset - at);
+			};
+
+			put(&h, sizeof(h));
+			pad_to(h.nodes_at);
+			for (auto i = std::size_t{0}; i < g.num_nodes(); ++i) {
+				put(&g.node(i), sizeof(N));
+			}
+			pad_to(h.offsets_at);
+			for (auto const offset : g.offsets()) {
+				auto const o = static_cast<std::uint64_t>(offset);
+				put(&o, sizeof(o));
+			}
+			pad_to(h.targets_at);
+			for (auto i = std::size_t{0}; i < g.num_nodes(); ++i) {
+				auto const t = g.targets(i);
+				put(t.data(), t.size_bytes());
+			}
+			pad_to(h.weights_at);
+			for (auto i = std::size_t{0}; i < g.num_nodes(); ++i) {
+				auto const w = g.edge_weights(i);
+				put(w.data(), w.size_bytes());
+			}
+		}
+
+		// Maps a file made by write().
+		explicit mapped_graph(std::filesystem::path const& path) {
+			auto const fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+			if (fd < 0) {
+				throw std::runtime_error("Cannot construct gdwg::mapped_graph<N, E> from a file that "
+				                         "can't be opened");
+			}
+			struct ::stat st = {};
+			auto const stat_failed = ::fstat(fd, &st) != 0;
+			size_ = stat_failed ? 0 : static_cast<std::size_t>(st.st_size);
+			if (size_ >= sizeof(header)) {
+				auto* const base = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+				base_ = base == MAP_FAILED ? nullptr : base;
+			}
+			::close(fd);
+			if (base_ == nullptr or not attach()) {
+				unmap();
+				throw std::runtime_error("Cannot construct gdwg::mapped_graph<N, E> from a file that "
+				                         "doesn't hold a mapped graph");
+			}
+		}
+
+		mapped_graph(mapped_graph const&) = delete;
+		auto operator=(mapped_graph const&) -> mapped_graph& = delete;
+
+		mapped_graph(mapped_graph&& other) noexcept
+		: base_{std::exchange(other.base_, nullptr)}
+		, size_{std::exchange(other.size_, 0)}
+		, csr_{std::exchange(other.csr_, {})} {}
+
+		auto operator=(mapped_graph&& other) noexcept -> mapped_graph& {
+			std::swap(base_, other.base_);
+			std::swap(size_, other.size_);
+			std::swap(csr_, other.csr_);
+			return *this;
+		}
+
+		~mapped_graph() {
+			unmap();
+		}
+
+		// Accessors
+		[[nodiscard]] auto is_node(N const& value) const -> bool {
+			return csr_.is_node(value);
+		}
+
+		[[nodiscard]] auto empty() const -> bool {
+			return csr_.empty();
+		}
+
+		// log(n) + log(out-degree)
+		[[nodiscard]] auto is_connected(N const& src, N const& dst) const -> bool {
+			return csr_.is_connected(src, dst);
+		}
+
+		[[nodiscard]] auto nodes() const -> std::vector<N> {
+			return csr_.nodes();
+		}
+
+		// log(n) + log(out-degree)
+		[[nodiscard]] auto weights(N const& src, N const& dst) const -> std::vector<E> {
+			return csr_.weights(src, dst);
+		}
+
+		// log(n) + log(out-degree)
+		[[nodiscard]] auto find(N const& src, N const& dst, E const& weight) const -> iterator {
+			return csr_.find(src, dst, weight);
+		}
+
+		// log(n) + out-degree
+		[[nodiscard]] auto connections(N const& src) const -> std::vector<N> {
+			return csr_.connections(src);
+		}
+
+		// Checks that every row of offsets lies inside targets and that every target is a node,
+		// so that no query reads outside the mapping. Reads the offsets and targets arrays once,
+		// front to back.
+		auto verify() const -> void {
+			auto const offsets = csr_.offsets();
+			auto const n = num_nodes();
+			if (not std::is_sorted(offsets.begin(), offsets.end())
+			    or not std::ranges::all_of(csr_.all_targets(), [n](index_type t) { return t < n; }))
+			{
+				throw std::runtime_error("Cannot call gdwg::mapped_graph<N, E>::verify on a file "
+				                         "whose offsets or targets are corrupt");
+			}
+		}
+
+		// Index-based access, as on frozen_graph.
+		[[nodiscard]] auto num_nodes() const noexcept -> std::size_t {
+			return csr_.num_nodes();
+		}
+
+		[[nodiscard]] auto num_edges() const noexcept -> std::size_t {
+			return csr_.num_edges();
+		}
+
+		// Returns num_nodes() if value isn't a node.
+		[[nodiscard]] auto find_index(N const& value) const -> std::size_t {
+			return csr_.find_index(value);
+		}
+
+		[[nodiscard]] auto node(std::size_t i) const -> N const& {
+			return csr_.node(i);
+		}
+
+		[[nodiscard]] auto offsets() const noexcept -> std::span<std::uint64_t const> {
+			return csr_.offsets();
+		}
+
+		[[nodiscard]] auto targets(std::size_t i) const -> std::span<index_type const> {
+			return csr_.targets(i);
+		}
+
+		[[nodiscard]] auto edge_weights(std::size_t i) const -> std::span<E const> {
+			return csr_.edge_weights(i);
+		}
+
+		[[nodiscard]] auto out_degree(std::size_t i) const -> std::size_t {
+			return csr_.out_degree(i);
+		}
+
+		// Iterator
+		[[nodiscard]] auto begin() const -> iterator {
+			return csr_.begin();
+		}
+
+		[[nodiscard]] auto end() const -> iterator {
+			return csr_.end();
+		}
+
+	private:
+		// Section offsets are from the start of the file and multiples of section_alignment.
+		struct header {
+			char magic[8];
+			std::uint32_t version;
+			std::uint32_t byte_order;
+			std::uint32_t node_size;
+			std::uint32_t weight_size;
+			std::uint64_t num_nodes;
+			std::uint64_t num_edges;
+			std::uint64_t nodes_at;
+			std::uint64_t offsets_at;
+			std::uint64_t targets_at;
+			std::uint64_t weights_at;
+			std::uint64_t file_size;
+		};
+
+		static constexpr char file_magic[8] = {'G', 'D', 'W', 'G', 'C', 'S', 'R', '\0'};
+		static constexpr auto file_version = std::uint32_t{1};
+		// Reads back as something else on a machine of the other byte order.
+		static constexpr auto byte_order_mark = std::uint32_t{0x01020304};
+		static constexpr auto section_alignment = std::size_t{64};
+
+		static_assert(alignof(N) <= section_alignment and alignof(E) <= section_alignment);
+
+		void* base_ = nullptr;
+		std::size_t size_ = 0;
+		view_type csr_;
+
+		static constexpr auto align(std::uint64_t offset) noexcept -> std::uint64_t {
+			return (offset + section_alignment - 1) / section_alignment * section_alignment;
+		}
+
+		// Checks the header against the file and points the view into the mapping. O(1)
+		auto attach() -> bool {
+			auto h = header{};
+			std::memcpy(&h, base_, sizeof(h));
+			auto const fits = [this](std::uint64_t at, std::uint64_t count, std::uint64_t size) {
+				return at % section_alignment == 0 and at <= size_
+				       and count <= (size_ - at) / size;
+			};
+			if (std::memcmp(h.magic, file_magic, sizeof(file_magic)) != 0
+			    or h.version != file_version or h.byte_order != byte_order_mark
+			    or h.node_size != sizeof(N) or h.weight_size != sizeof(E) or h.file_size != size_
+			    or h.num_nodes >= size_ or not fits(h.nodes_at, h.num_nodes, sizeof(N))
+			    or not fits(h.offsets_at, h.num_nodes + 1, sizeof(std::uint64_t))
+			    or not fits(h.targets_at, h.num_edges, sizeof(index_type))
+			    or not fits(h.weights_at, h.num_edges, sizeof(E)))
+			{
+				return false;
+			}
+
+			auto const* const bytes = static_cast<std::byte const*>(base_);
+			auto const offsets = std::span<std::uint64_t const>(
+			   reinterpret_cast<std::uint64_t const*>(bytes + h.offsets_at),
+			   h.num_nodes + 1);
+			auto const targets = std::span<index_type const>(
+			   reinterpret_cast<index_type const*>(bytes + h.targets_at),
+			   h.num_edges);
+			if (offsets.front() != 0 or offsets.back() != h.num_edges) {
+				return false;
+			}
+			csr_ = view_type("gdwg::mapped_graph<N, E>",
+			                 {reinterpret_cast<N const*>(bytes + h.nodes_at), h.num_nodes},
+			                 offsets,
+			                 targets,
+			                 {reinterpret_cast<E const*>(bytes + h.weights_at), h.num_edges});
+			return true;
+		}
+
+		auto unmap() noexcept -> void {
+			if (base_ != nullptr) {
+				::munmap(base_, size_);
+			}
+			base_ = nullptr;
+			size_ = 0;
+			csr_ = {};
+		}
+
+		// Hidden Friend: Extractor
+		friend auto operator<<(std::ostream& os, mapped_graph const& g) -> std::ostream& {
+			return os << g.csr_;
+		}
+	};
+} // namespace gdwg
+
+#endif // GDWG_MAPPED_GRAPH_HPP
@@ -0,0 +1,205 @@
+#ifndef GDWG_PAGERANK_HPP
+#define GDWG_PAGERANK_HPP
+
+#include <algorithm>
+#include <barrier>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include "gdwg/frozen_graph.hpp"
+#include "gdwg/parallel.hpp"
+
+namespace gdwg {
+	namespace detail {
+		// Stops a pagerank() that hasn't converged by then, as with damping = 1 on some graphs.
+		inline constexpr auto pagerank_max_iterations = 1000;
+
+		// One pagerank() run. Each iteration is two steps, each ended by a barrier whose
+		// completion runs alone: every thread first works out what its own nodes pass along each
+		// out-edge, then pulls those shares in over its nodes' in-edges. A thread only writes
+		// its own nodes, so nothing needs to be atomic.
+		template<typename Index>
+		struct pagerank_run {
+			// Per-thread sums, on separate cache lines so threads don't share them.
+			struct alignas(64) partial {
+				double dangling = 0;
+				double change = 0;
+			};
+
+			reverse_rows<Index> const& in;
+			std::size_t num_nodes;
+			double damping;
+			double tolerance;
+			// Nodes [bounds[t], bounds[t + 1]) belong to thread t.
+			std::vector<std::size_t> bounds;
+			// 1 / out-degree, or 0 for a node without out-edges.
+			std::vector<double> inverse_degree;
+			// Nodes without out-edges, grouped by thread; those of thread t start at
+			// dangling_bounds[t].
+			std::vector<Index> dangling;
+			std::vector<std::size_t> dangling_bounds;
+
+			std::vector<double> rank;
+			std::vector<double> next;
+			std::vector<double> share;
+			std::vector<partial> partials;
+			// What every node gets before its in-edges: the random jump and the dangling nodes.
+			double base = 0;
+			int iterations = 0;
+			bool pulling = false;
+			bool done = false;
+
+			struct finish_step {
+				pagerank_run* run;
+
+				auto operator()() const noexcept -> void {
+					run->advance();
+				}
+			};
+
+			std::barrier<finish_step> sync;
+
+			template<typename N, typename E>
+			pagerank_run(frozen_graph<N, E> const& g,
+			             reverse_rows<Index> const& rows,
+			             double d,
+			             double t,
+			             unsigned threads)
+			: in{rows}
+			, num_nodes{g.num_nodes()}
+			, damping{d}
+			, tolerance{t}
+			, bounds(threads + 1, num_nodes)
+			, inverse_degree(num_nodes)
+			, dangling_bounds(threads + 1)
+			, rank(num_nodes, 1.0 / static_cast<double>(num_nodes))
+			, next(num_nodes)
+			, share(num_nodes)
+			, partials(threads)
+			, sync{static_cast<std::ptrdiff_t>(threads), finish_step{this}} {
+				// Pulling costs a node its in-degree plus a little, so that is what's balanced.
+				auto const cost = [this](std::size_t v) { return in.offsets[v] + v; };
+				auto const total = cost(num_nodes);
+				bounds[0] = 0;
+				for (auto t = std::size_t{1}; t < threads; ++t) {
+					auto v = bounds[t - 1];
+					while (v < num_nodes and cost(v) < total * t / threads) {
+						++v;
+					}
+					bounds[t] = v;
+				}
+				for (auto t = std::size_t{0}; t < threads; ++t) {
+					dangling_bounds[t] = dangling.size();
+					for (auto v = bounds[t]; v < bounds[t + 1]; ++v) {
+						auto const degree = g.out_degree(v);
+						if (degree == 0) {
+							dangling.push_back(static_cast<Index>(v));
+						}
+						else {
+							inverse_degree[v] = 1.0 / static_cast<double>(degree);
+						}
+					}
+				}
+				dangling_bounds[threads] = dangling.size();
+			}
+
+			auto work(unsigned t) -> void {
+				auto const first = bounds[t];
+				auto const last = bounds[t + 1];
+				auto& sums = partials[t];
+				while (not done) {
+					// Plain loops over contiguous arrays, which the compiler vectorises.
+					auto const* const r = rank.data();
+					auto const* const inverse = inverse_degree.data();
+					auto* const s = share.data();
+					for (auto u = first; u < last; ++u) {
+						s[u] = r[u] * inverse[u];
+					}
+					auto dangling_rank = 0.0;
+					for (auto i = dangling_bounds[t]; i < dangling_bounds[t + 1]; ++i) {
+						dangling_rank += r[dangling[i]];
+					}
+					sums.dangling = dangling_rank;
+					sync.arrive_and_wait();
+
+					auto const* const offsets = in.offsets.data();
+					auto const* const sources = in.sources.data();
+					auto* const updated = next.data();
+					auto change = 0.0;
+					for (auto v = first; v < last; ++v) {
+						auto pulled = 0.0;
+						for (auto i = offsets[v]; i < offsets[v + 1]; ++i) {
+							pulled += s[sources[i]];
+						}
+						updated[v] = base + damping * pulled;
+						change += std::abs(updated[v] - r[v]);
+					}
+					sums.change = change;
+					sync.arrive_and_wait();
+				}
+			}
+
+			auto advance() noexcept -> void {
+				auto const n = static_cast<double>(num_nodes);
+				if (not pulling) {
+					auto dangling_rank = 0.0;
+					for (auto const& p : partials) {
+						dangling_rank += p.dangling;
+					}
+					base = (1 - damping) / n + damping * dangling_rank / n;
+				}
+				else {
+					auto change = 0.0;
+					for (auto const& p : partials) {
+						change += p.change;
+					}
+					std::swap(rank, next);
+					++iterations;
+					done = change < tolerance or iterations == pagerank_max_iterations;
+				}
+				pulling = not pulling;
+			}
+		};
+	} // namespace detail
+
+	// PageRank of every node of a snapshot, by node index; the ranks add up to 1. Each edge is a
+	// link from its source to its destination whatever its weight, so parallel edges count
+	// once each, and a node without out-edges links to every node. Iterates until an iteration
+	// changes the ranks by less than tolerance in total (their L1 distance), on the given number
+	// of threads.
+	//
+	// O(n + e) per iteration. The ranks are pulled along the snapshot's edges reversed, which
+	// are built once per call in O(n + e).
+	template<typename N, typename E>
+	[[nodiscard]] auto pagerank(frozen_graph<N, E> const& g,
+	                            double damping = 0.85,
+	                            double tolerance = 1e-6,
+	                            unsigned threads = detail::default_threads())
+	   -> std::vector<double> {
+		if (not(damping >= 0 and damping <= 1)) {
+			throw std::runtime_error("Cannot call gdwg::pagerank with a damping factor outside "
+			                         "[0, 1]");
+		}
+		if (not(tolerance > 0)) {
+			throw std::runtime_error("Cannot call gdwg::pagerank with a tolerance that isn't "
+			                         "positive");
+		}
+		if (g.empty()) {
+			return {};
+		}
+		auto const rows = detail::reverse(g);
+		threads = static_cast<unsigned>(
+		   std::clamp(std::size_t{threads}, std::size_t{1}, g.num_nodes()));
+		auto run = detail::pagerank_run<typename frozen_graph<N, E>::index_type>(g,
+		                                                                         rows,
+		                                                                         damping,
+		                                                                         tolerance,
+		                                                                         threads);
+		detail::run_threads(threads, [&run](unsigned t) { run.work(t); });
+		return std::move(run.rank);
+	}
+} // namespace gdwg
+
+#endif // GDWG_PAGERANK_HPP
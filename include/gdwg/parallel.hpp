@@ -0,0 +1,67 @@
+#ifndef GDWG_PARALLEL_HPP
+#define GDWG_PARALLEL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <latch>
+#include <thread>
+#include <vector>
+
+namespace gdwg::detail {
+	// The number of threads the machine can run at once, or 1 if it doesn't say.
+	inline auto default_threads() noexcept -> unsigned {
+		return std::max(1U, std::thread::hardware_concurrency());
+	}
+
+	// Calls f(t) for every t below threads, each on a thread of its own; the calling thread runs
+	// f(0). Returns once every call has. No call starts until every thread exists, so calls that
+	// wait for each other, at a barrier say, are never left waiting for one that didn't start: if
+	// a thread can't be made, f isn't called at all and the error is rethrown.
+	template<typename F>
+	auto run_threads(unsigned threads, F const& f) -> void {
+		// Declared before workers, so they outlive the joins in its destructor.
+		auto start = std::latch(1);
+		auto go = false;
+		auto workers = std::vector<std::jthread>{};
+		try {
+			workers.reserve(threads - 1);
+			for (auto t = 1U; t < threads; ++t) {
+				workers.emplace_back([&f, &start, &go, t] {
+					start.wait();
+					if (go) {
+						f(t);
+					}
+				});
+			}
+		} catch (...) {
+			start.count_down();
+			throw;
+		}
+		// count_down() happens before wait() returns, so every worker sees go.
+		go = true;
+		start.count_down();
+		f(0U);
+	}
+
+	// Calls f(i) for every i below size, on the given number of threads. Each thread takes chunk
+	// indices at a time until none are left, so uneven work still spreads out.
+	template<typename F>
+	auto parallel_for(unsigned threads, std::size_t size, std::size_t chunk, F const& f) -> void {
+		auto cursor = std::atomic<std::size_t>(0);
+		run_threads(threads, [&cursor, size, chunk, &f](unsigned) {
+			for (;;) {
+				auto const first = cursor.fetch_add(chunk, std::memory_order_relaxed);
+				if (first >= size) {
+					return;
+				}
+				auto const last = std::min(first + chunk, size);
+				for (auto i = first; i < last; ++i) {
+					f(i);
+				}
+			}
+		});
+	}
+} // namespace gdwg::detail
+
+#endif // GDWG_PARALLEL_HPP
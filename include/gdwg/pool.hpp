@@ -0,0 +1,164 @@
+#ifndef GDWG_POOL_HPP
+#define GDWG_POOL_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace gdwg::detail {
+	// Memory for the chunks of one graph's trees and tables. Blocks are carved out of slabs that
+	// double in size up to a cap, and a freed block goes on a free list for its size, so node
+	// splits and copies on write reuse memory instead of going to the global heap. The arena is
+	// shared: copying a node_arena names the same arena, the trees of a graph and of all its
+	// copies hold one, and the slabs go back to the heap in one go when the last of them lets go.
+	// Blocks freed before then stay in the arena for reuse. Copies of a graph may live on
+	// different threads, so allocate() and deallocate() take a lock. A default-constructed
+	// node_arena names no arena and falls back to new and delete.
+	class node_arena {
+	public:
+		node_arena() noexcept = default;
+
+		[[nodiscard]] static auto make() -> node_arena {
+			auto arena = node_arena{};
+			arena.state_ = new state;
+			return arena;
+		}
+
+		node_arena(node_arena const& other) noexcept
+		: state_{other.state_} {
+			if (state_ != nullptr) {
+				state_->refs.fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+
+		node_arena(node_arena&& other) noexcept
+		: state_{std::exchange(other.state_, nullptr)} {}
+
+		auto operator=(node_arena const& other) noexcept -> node_arena& {
+			auto copy = other;
+			swap(copy);
+			return *this;
+		}
+
+		auto operator=(node_arena&& other) noexcept -> node_arena& {
+			swap(other);
+			return *this;
+		}
+
+		~node_arena() {
+			if (state_ != nullptr and state_->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+				delete state_;
+			}
+		}
+
+		auto swap(node_arena& other) noexcept -> void {
+			std::swap(state_, other.state_);
+		}
+
+		[[nodiscard]] auto allocate(std::size_t bytes, std::size_t alignment) -> void* {
+			if (state_ == nullptr or not pooled(bytes, alignment)) {
+				return ::operator new(bytes, std::align_val_t{alignment});
+			}
+			auto const lock = std::lock_guard{state_->mutex};
+			return state_->take(size_class(bytes));
+		}
+
+		auto deallocate(void* p, std::size_t bytes, std::size_t alignment) noexcept -> void {
+			if (state_ == nullptr or not pooled(bytes, alignment)) {
+				::operator delete(p, std::align_val_t{alignment});
+				return;
+			}
+			auto const lock = std::lock_guard{state_->mutex};
+			state_->give_back(p, size_class(bytes));
+		}
+
+		// Bytes of slab allocated so far, in use or not.
+		[[nodiscard]] auto capacity() const -> std::size_t {
+			if (state_ == nullptr) {
+				return 0;
+			}
+			auto const lock = std::lock_guard{state_->mutex};
+			return state_->capacity;
+		}
+
+		auto operator==(node_arena const& other) const noexcept -> bool = default;
+
+	private:
+		// Blocks are whole numbers of granules, which also sets their alignment. Bigger blocks
+		// than the largest class are rare enough to leave to the heap.
+		static constexpr auto granule = std::size_t{64};
+		static constexpr auto classes = std::size_t{256};
+		static constexpr auto first_slab_size = std::size_t{4096};
+		static constexpr auto max_slab_size = std::size_t{1} << 18;
+
+		[[nodiscard]] static constexpr auto pooled(std::size_t bytes,
+		                                           std::size_t alignment) noexcept -> bool {
+			return bytes <= classes * granule and alignment <= granule;
+		}
+
+		// Granules in a block of bytes.
+		[[nodiscard]] static constexpr auto size_class(std::size_t bytes) noexcept
+		   -> std::size_t {
+			return std::max((bytes + granule - 1) / granule, std::size_t{1});
+		}
+
+		struct state {
+			std::atomic<std::uint32_t> refs = 1;
+			std::mutex mutex;
+			std::vector<std::byte*> slabs;
+			// The head of each size class's free list, which links through the blocks.
+			std::array<void*, classes + 1> free = {};
+			std::byte* cursor = nullptr;
+			std::byte* end = nullptr;
+			std::size_t capacity = 0;
+
+			state() = default;
+			state(state const&) = delete;
+			auto operator=(state const&) -> state& = delete;
+
+			~state() {
+				for (auto* const slab : slabs) {
+					::operator delete(slab, std::align_val_t{granule});
+				}
+			}
+
+			auto take(std::size_t c) -> void* {
+				if (free[c] != nullptr) {
+					return std::exchange(free[c], *static_cast<void**>(free[c]));
+				}
+				auto const bytes = c * granule;
+				if (static_cast<std::size_t>(end - cursor) < bytes) {
+					auto const size =
+					   std::max(std::clamp(capacity, first_slab_size, max_slab_size), bytes);
+					slabs.reserve(slabs.size() + 1);
+					auto* const slab =
+					   static_cast<std::byte*>(::operator new(size, std::align_val_t{granule}));
+					// What is left of the old slab is smaller than one block, so it fits a class.
+					if (cursor != end) {
+						give_back(cursor, static_cast<std::size_t>(end - cursor) / granule);
+					}
+					slabs.push_back(slab);
+					cursor = slab;
+					end = slab + size;
+					capacity += size;
+				}
+				return std::exchange(cursor, cursor + bytes);
+			}
+
+			auto give_back(void* p, std::size_t c) noexcept -> void {
+				*static_cast<void**>(p) = free[c];
+				free[c] = p;
+			}
+		};
+
+		state* state_ = nullptr;
+	};
+} // namespace gdwg::detail
+
+#endif // GDWG_POOL_HPP
@@ -0,0 +1,201 @@
+#ifndef GDWG_RADIX_TABLE_HPP
+#define GDWG_RADIX_TABLE_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+#include "gdwg/pool.hpp"
+
+namespace gdwg::detail {
+	// Array indexed by 32-bit integers, held in a radix tree of reference-counted chunks that
+	// copies share: copying a table is O(1), and write() copies only the chunks on the path to
+	// its element that another table also holds, so a write to a copy costs one leaf of 64
+	// elements and a few small inner nodes however big the table is. Elements never written
+	// read as T{}. A reference from write() stays valid until the table is next copied or cleared.
+	// Chunks come from the table's arena, which copies share.
+	template<typename T>
+	class radix_table {
+	public:
+		radix_table() noexcept = default;
+
+		explicit radix_table(node_arena arena) noexcept
+		: arena_{std::move(arena)} {}
+
+		radix_table(radix_table const& other) noexcept
+		: root_{other.root_}
+		, height_{other.height_}
+		, arena_{other.arena_} {
+			retain(root_);
+		}
+
+		radix_table(radix_table&& other) noexcept
+		: root_{std::exchange(other.root_, nullptr)}
+		, height_{std::exchange(other.height_, 0)}
+		, arena_{other.arena_} {}
+
+		auto operator=(radix_table const& other) noexcept -> radix_table& {
+			auto copy = other;
+			swap(copy);
+			return *this;
+		}
+
+		auto operator=(radix_table&& other) noexcept -> radix_table& {
+			swap(other);
+			return *this;
+		}
+
+		~radix_table() {
+			release(root_, height_);
+		}
+
+		auto swap(radix_table& other) noexcept -> void {
+			std::swap(root_, other.root_);
+			std::swap(height_, other.height_);
+			arena_.swap(other.arena_);
+		}
+
+		[[nodiscard]] auto operator[](std::size_t i) const noexcept -> T const& {
+			static T const none{};
+			if (root_ == nullptr or i >= capacity(height_)) {
+				return none;
+			}
+			auto const* n = root_;
+			for (auto h = height_; h > 0; --h) {
+				n = static_cast<inner const*>(n)->children[digit(i, h)];
+				if (n == nullptr) {
+					return none;
+				}
+			}
+			return static_cast<leaf const*>(n)->items[i % leaf_size];
+		}
+
+		// Element i, in chunks of this table's own: any on the way that another table holds are
+		// copied and any missing are made. Throws, changing nothing that can be read, if that
+		// fails.
+		auto write(std::size_t i) -> T& {
+			while (i >= capacity(height_)) {
+				if (root_ != nullptr) {
+					auto* const up = make<inner>();
+					up->children[0] = root_;
+					root_ = up;
+				}
+				++height_;
+			}
+			auto** slot = &root_;
+			for (auto h = height_;; --h) {
+				own(*slot, h);
+				if (h == 0) {
+					return static_cast<leaf*>(*slot)->items[i % leaf_size];
+				}
+				slot = &static_cast<inner*>(*slot)->children[digit(i, h)];
+			}
+		}
+
+		auto clear() noexcept -> void {
+			release(std::exchange(root_, nullptr), std::exchange(height_, 0));
+		}
+
+	private:
+		static constexpr auto leaf_size = std::size_t{64};
+		static constexpr auto inner_size = std::size_t{256};
+
+		struct node {
+			std::atomic<std::uint32_t> refs = 1;
+		};
+
+		struct leaf : node {
+			std::array<T, leaf_size> items = {};
+
+			leaf() = default;
+
+			explicit leaf(std::array<T, leaf_size> const& other)
+			: items{other} {}
+		};
+
+		struct inner : node {
+			std::array<node*, inner_size> children = {};
+		};
+
+		// Inner levels above the leaves.
+		node* root_ = nullptr;
+		unsigned height_ = 0;
+		node_arena arena_;
+
+		static constexpr auto capacity(unsigned height) noexcept -> std::size_t {
+			return leaf_size << (8 * height);
+		}
+
+		// Which child of a node at height h holds element i.
+		static constexpr auto digit(std::size_t i, unsigned h) noexcept -> std::size_t {
+			return (i >> (6 + 8 * (h - 1))) % inner_size;
+		}
+
+		static auto retain(node* n) noexcept -> void {
+			if (n != nullptr) {
+				n->refs.fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+
+		template<typename Node, typename... Args>
+		auto make(Args const&... args) -> Node* {
+			auto* const p = arena_.allocate(sizeof(Node), alignof(Node));
+			try {
+				return ::new (p) Node(args...);
+			} catch (...) {
+				arena_.deallocate(p, sizeof(Node), alignof(Node));
+				throw;
+			}
+		}
+
+		template<typename Node>
+		auto free(Node* n) noexcept -> void {
+			n->~Node();
+			arena_.deallocate(n, sizeof(Node), alignof(Node));
+		}
+
+		auto release(node* n, unsigned h) noexcept -> void {
+			if (n == nullptr or n->refs.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+				return;
+			}
+			if (h == 0) {
+				free(static_cast<leaf*>(n));
+				return;
+			}
+			auto* const in = static_cast<inner*>(n);
+			for (auto* const child : in->children) {
+				release(child, h - 1);
+			}
+			free(in);
+		}
+
+		// Makes slot point at a node of this table's own at height h.
+		auto own(node*& slot, unsigned h) -> void {
+			if (slot == nullptr) {
+				slot = h == 0 ? static_cast<node*>(make<leaf>()) : make<inner>();
+				return;
+			}
+			if (slot->refs.load(std::memory_order_acquire) == 1) {
+				return;
+			}
+			node* copy = nullptr;
+			if (h == 0) {
+				copy = make<leaf>(static_cast<leaf const*>(slot)->items);
+			}
+			else {
+				auto* const in = make<inner>();
+				in->children = static_cast<inner const*>(slot)->children;
+				for (auto* const child : in->children) {
+					retain(child);
+				}
+				copy = in;
+			}
+			release(std::exchange(slot, copy), h);
+		}
+	};
+} // namespace gdwg::detail
+
+#endif // GDWG_RADIX_TABLE_HPP
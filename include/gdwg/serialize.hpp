@@ -0,0 +1,112 @@
+#ifndef GDWG_SERIALIZE_HPP
+#define GDWG_SERIALIZE_HPP
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ios>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <type_traits>
+
+namespace gdwg {
+	// Customisation point for graph::save() and graph::load(): how one N or E is written and read
+	// back. Specialise it for your own types, with
+	//     static auto write(std::ostream&, T const&) -> void;
+	//     static auto read(std::istream&) -> T;
+	// read() should throw or leave the stream failed if the bytes don't make sense. Arithmetic
+	// types and std::string are provided.
+	template<typename T>
+	struct serializer;
+
+	namespace detail {
+		// Unformatted I/O straight on the stream buffer. Values are only a few bytes each, and
+		// istream::read and ostream::write build a sentry for every call.
+		inline auto put_bytes(std::ostream& os, char const* bytes, std::size_t n) -> void {
+			auto const size = static_cast<std::streamsize>(n);
+			auto* const buffer = os.rdbuf();
+			if (not os or buffer == nullptr or buffer->sputn(bytes, size) != size) {
+				os.setstate(std::ios_base::badbit);
+			}
+		}
+
+		inline auto get_bytes(std::istream& is, char* bytes, std::size_t n) -> bool {
+			auto const size = static_cast<std::streamsize>(n);
+			auto* const buffer = is.rdbuf();
+			if (not is or buffer == nullptr or buffer->sgetn(bytes, size) != size) {
+				is.setstate(std::ios_base::eofbit | std::ios_base::failbit);
+				return false;
+			}
+			return true;
+		}
+
+		// Numbers are stored little-endian whatever the host is, so files move between machines.
+		template<typename T>
+		auto write_raw(std::ostream& os, T value) -> void {
+			static_assert(std::is_trivially_copyable_v<T>);
+			char bytes[sizeof(T)];
+			std::memcpy(bytes, &value, sizeof(T));
+			if constexpr (std::endian::native == std::endian::big) {
+				std::reverse(bytes, bytes + sizeof(T));
+			}
+			put_bytes(os, bytes, sizeof(T));
+		}
+
+		// Returns T{} and leaves is failed if the stream runs out.
+		template<typename T>
+		auto read_raw(std::istream& is) -> T {
+			static_assert(std::is_trivially_copyable_v<T>);
+			char bytes[sizeof(T)];
+			if (not get_bytes(is, bytes, sizeof(T))) {
+				return T{};
+			}
+			if constexpr (std::endian::native == std::endian::big) {
+				std::reverse(bytes, bytes + sizeof(T));
+			}
+			auto value = T{};
+			std::memcpy(&value, bytes, sizeof(T));
+			return value;
+		}
+	} // namespace detail
+
+	template<typename T>
+	requires std::is_arithmetic_v<T>
+	struct serializer<T> {
+		static auto write(std::ostream& os, T const& value) -> void {
+			detail::write_raw(os, value);
+		}
+
+		static auto read(std::istream& is) -> T {
+			return detail::read_raw<T>(is);
+		}
+	};
+
+	// Length, then the characters.
+	template<>
+	struct serializer<std::string> {
+		static auto write(std::ostream& os, std::string const& value) -> void {
+			detail::write_raw(os, static_cast<std::uint64_t>(value.size()));
+			detail::put_bytes(os, value.data(), value.size());
+		}
+
+		static auto read(std::istream& is) -> std::string {
+			auto const size = detail::read_raw<std::uint64_t>(is);
+			auto value = std::string{};
+			// Grown as it is read, so that a corrupt length can't ask for a huge allocation.
+			constexpr auto chunk = std::uint64_t{1} << 16;
+			for (auto left = size; is and left > 0;) {
+				auto const n = static_cast<std::size_t>(left < chunk ? left : chunk);
+				auto const old_size = value.size();
+				value.resize(old_size + n);
+				detail::get_bytes(is, value.data() + old_size, n);
+				left -= n;
+			}
+			return value;
+		}
+	};
+} // namespace gdwg
+
+#endif // GDWG_SERIALIZE_HPP
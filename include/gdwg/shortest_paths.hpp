@@ -0,0 +1,224 @@
+#ifndef GDWG_SHORTEST_PATHS_HPP
+#define GDWG_SHORTEST_PATHS_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "gdwg/graph.hpp"
+
+namespace gdwg {
+	namespace detail {
+		// Min-heap of (key, id) pairs for ids below a fixed bound, with decrease-key. Each entry
+		// has D children, so the heap is shallower than a binary one and the children compared
+		// when sifting down sit next to each other in memory. Where each id sits is kept in a
+		// dense array, so finding it costs nothing.
+		template<typename Key, std::size_t D = 4>
+		class indexed_heap {
+		public:
+			explicit indexed_heap(std::size_t id_bound)
+			: position_(id_bound, absent) {}
+
+			[[nodiscard]] auto empty() const noexcept -> bool {
+				return entries_.empty();
+			}
+
+			// Adds id with key, or lowers its key to key if it's already in the heap.
+			auto push_or_decrease(std::uint32_t id, Key const& key) -> void {
+				auto i = position_[id];
+				if (i == absent) {
+					i = static_cast<std::uint32_t>(entries_.size());
+					entries_.push_back(entry{key, id});
+				}
+				else {
+					entries_[i].key = key;
+				}
+				sift_up(i);
+			}
+
+			// Removes the entry with the least key.
+			auto pop() -> std::pair<Key, std::uint32_t> {
+				auto const top = entries_.front();
+				position_[top.id] = absent;
+				auto const last = entries_.back();
+				entries_.pop_back();
+				if (not entries_.empty()) {
+					entries_.front() = last;
+					sift_down(0);
+				}
+				return {top.key, top.id};
+			}
+
+		private:
+			static constexpr auto absent = std::numeric_limits<std::uint32_t>::max();
+
+			struct entry {
+				Key key;
+				std::uint32_t id;
+			};
+
+			std::vector<entry> entries_;
+			std::vector<std::uint32_t> position_;
+
+			// Moves the hole at i up past every parent with a greater key, then fills it.
+			auto sift_up(std::uint32_t i) -> void {
+				auto const moving = entries_[i];
+				while (i > 0) {
+					auto const parent = (i - 1) / D;
+					if (not(moving.key < entries_[parent].key)) {
+						break;
+					}
+					place(i, entries_[parent]);
+					i = static_cast<std::uint32_t>(parent);
+				}
+				place(i, moving);
+			}
+
+			auto sift_down(std::uint32_t i) -> void {
+				auto const moving = entries_[i];
+				auto const size = entries_.size();
+				for (;;) {
+					auto const first = std::size_t{i} * D + 1;
+					if (first >= size) {
+						break;
+					}
+					auto const last = std::min(first + D, size);
+					auto least = first;
+					for (auto c = first + 1; c < last; ++c) {
+						if (entries_[c].key < entries_[least].key) {
+							least = c;
+						}
+					}
+					if (not(entries_[least].key < moving.key)) {
+						break;
+					}
+					place(i, entries_[least]);
+					i = static_cast<std::uint32_t>(least);
+				}
+				place(i, moving);
+			}
+
+			auto place(std::uint32_t i, entry const& e) -> void {
+				entries_[i] = e;
+				position_[e.id] = i;
+			}
+		};
+	} // namespace detail
+
+	// What shortest_paths() finds, in arrays indexed by node id as returned by graph::id_of().
+	// Both arrays are id_bound() long; ids that don't belong to a node are unreachable.
+	template<typename NodeId, typename E>
+	struct shortest_path_tree {
+		// The distance of a node the source can't reach.
+		static constexpr auto unreachable = std::numeric_limits<E>::has_infinity
+		                                       ? std::numeric_limits<E>::infinity()
+		                                       : std::numeric_limits<E>::max();
+		// The predecessor of a node the source can't reach.
+		static constexpr auto no_node = NodeId{std::numeric_limits<std::uint32_t>::max()};
+
+		// Sum of the weights along a shortest path from the source.
+		std::vector<E> distance;
+		// The node before each one on its shortest path. The source is its own predecessor.
+		std::vector<NodeId> predecessor;
+
+		[[nodiscard]] auto reached(NodeId id) const -> bool {
+			return predecessor[static_cast<std::size_t>(id)] != no_node;
+		}
+
+		// The nodes on a shortest path from the source to dst, both included; empty if dst
+		// can't be reached.
+		[[nodiscard]] auto path_to(NodeId dst) const -> std::vector<NodeId> {
+			auto path = std::vector<NodeId>{};
+			if (reached(dst)) {
+				for (auto id = dst;; id = predecessor[static_cast<std::size_t>(id)]) {
+					path.push_back(id);
+					if (predecessor[static_cast<std::size_t>(id)] == id) {
+						break;
+					}
+				}
+				std::reverse(path.begin(), path.end());
+			}
+			return path;
+		}
+	};
+
+	// Dijkstra's algorithm from source over every edge of g, in O((n + e) log n). The nodes are
+	// visited by id and their edges walked in place; of several edges to the same node, only the
+	// lightest, which comes first, is looked at. Throws if it comes across a negative weight. A
+	// path whose length is too big for E is skipped, as if its last edge weren't there, so a node
+	// reached only through such paths comes out unreachable rather than with a wrapped distance.
+	template<typename N, typename E, typename Layout>
+	requires std::is_arithmetic_v<E>
+	[[nodiscard]] auto shortest_paths(graph<N, E, Layout> const& g,
+	                                  typename graph<N, E, Layout>::node_id source)
+	   -> shortest_path_tree<typename graph<N, E, Layout>::node_id, E> {
+		using node_id = typename graph<N, E, Layout>::node_id;
+		using tree = shortest_path_tree<node_id, E>;
+		if (not g.is_node(source)) {
+			throw std::runtime_error("Cannot call gdwg::shortest_paths if source doesn't exist in "
+			                         "the graph");
+		}
+
+		auto const bound = g.id_bound();
+		auto result = tree{std::vector<E>(bound, tree::unreachable),
+		                   std::vector<node_id>(bound, tree::no_node)};
+		auto& distance = result.distance;
+		auto& predecessor = result.predecessor;
+		auto heap = detail::indexed_heap<E>(bound);
+
+		distance[static_cast<std::size_t>(source)] = E{};
+		predecessor[static_cast<std::size_t>(source)] = source;
+		heap.push_or_decrease(static_cast<std::uint32_t>(source), E{});
+		while (not heap.empty()) {
+			auto const [d, u] = heap.pop();
+			auto previous = std::optional<node_id>{};
+			for (auto const& [dst, weight] : g.out_edges(static_cast<node_id>(u))) {
+				if constexpr (std::is_signed_v<E>) {
+					if (weight < E{}) {
+						throw std::runtime_error("Cannot call gdwg::shortest_paths on a graph with "
+						                         "a negative weight");
+					}
+				}
+				if (dst == previous) {
+					continue;
+				}
+				previous = dst;
+				auto const v = static_cast<std::size_t>(dst);
+				// A float that overflows becomes infinity, which is never an improvement.
+				if constexpr (std::is_integral_v<E>) {
+					if (weight > tree::unreachable - d) {
+						continue;
+					}
+				}
+				auto const through = static_cast<E>(d + weight);
+				// With no negative weights, a node already taken off the heap is never improved on.
+				if (through < distance[v]) {
+					distance[v] = through;
+					predecessor[v] = static_cast<node_id>(u);
+					heap.push_or_decrease(static_cast<std::uint32_t>(v), through);
+				}
+			}
+		}
+		return result;
+	}
+
+	template<typename N, typename E, typename Layout>
+	requires std::is_arithmetic_v<E>
+	[[nodiscard]] auto shortest_paths(graph<N, E, Layout> const& g,
+	                                  std::type_identity_t<N> const& source)
+	   -> shortest_path_tree<typename graph<N, E, Layout>::node_id, E> {
+		if (auto const id = g.id_of(source)) {
+			return shortest_paths(g, *id);
+		}
+		throw std::runtime_error("Cannot call gdwg::shortest_paths if source doesn't exist in the "
+		                         "graph");
+	}
+} // namespace gdwg
+
+#endif // GDWG_SHORTEST_PATHS_HPP
@@ -0,0 +1,332 @@
+#ifndef GDWG_SMALL_TREE_HPP
+#define GDWG_SMALL_TREE_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "gdwg/btree.hpp"
+#include "gdwg/pool.hpp"
+
+namespace gdwg::detail {
+	// A btree<T> that keeps its first Inline elements in an array inside the object, by default
+	// as many as fit in a cache line, so a small sequence neither allocates nor chases pointers.
+	// Inserting one more moves them all into a btree whose nodes come from the arena passed in,
+	// which is used until the sequence is next emptied. The interface is btree's, and so are its
+	// guarantees: a modifier invalidates every iterator, and insert() and erase() either succeed
+	// or throw having changed nothing.
+	template<typename T,
+	         std::size_t Inline = std::max(std::size_t{1},
+	                                       std::max(std::size_t{64}, sizeof(btree<T>)) / sizeof(T))>
+	class small_tree {
+		static_assert(Inline > 0);
+
+		using tree_type = btree<T>;
+
+	public:
+		class iterator;
+		using value_type = T;
+		using const_iterator = iterator;
+
+		small_tree() noexcept {}
+
+		small_tree(small_tree const& other) {
+			if (other.spilled()) {
+				std::construct_at(&tree_, other.tree_);
+			}
+			else {
+				std::uninitialized_copy_n(other.items_, other.count_, items_);
+			}
+			count_ = other.count_;
+		}
+
+		small_tree(small_tree&& other) noexcept {
+			take(other);
+		}
+
+		auto operator=(small_tree const& other) -> small_tree& {
+			if (this != &other) {
+				auto copy = other;
+				*this = std::move(copy);
+			}
+			return *this;
+		}
+
+		auto operator=(small_tree&& other) noexcept -> small_tree& {
+			if (this != &other) {
+				destroy();
+				take(other);
+			}
+			return *this;
+		}
+
+		~small_tree() {
+			destroy();
+		}
+
+		[[nodiscard]] auto size() const noexcept -> std::size_t {
+			return spilled() ? tree_.size() : count_;
+		}
+
+		[[nodiscard]] auto empty() const noexcept -> bool {
+			return size() == 0;
+		}
+
+		// Whether the elements have moved out into a tree.
+		[[nodiscard]] auto spilled() const noexcept -> bool {
+			return count_ == spilled_count;
+		}
+
+		[[nodiscard]] auto begin() const -> iterator {
+			return at(0);
+		}
+
+		[[nodiscard]] auto end() const noexcept -> iterator {
+			return spilled() ? iterator{this, tree_.end()} : iterator{this, items_ + count_};
+		}
+
+		// The element of rank i, or end() if there is none.
+		[[nodiscard]] auto at(std::size_t i) const -> iterator {
+			if (spilled()) {
+				return iterator{this, tree_.at(i)};
+			}
+			return iterator{this, items_ + std::min(i, std::size_t{count_})};
+		}
+
+		template<typename K, typename Compare>
+		[[nodiscard]] auto lower_bound(K const& key, Compare cmp) const -> iterator {
+			if (spilled()) {
+				return iterator{this, tree_.lower_bound(key, cmp)};
+			}
+			return iterator{this, std::partition_point(items_, items_ + count_, [&](T const& x) {
+				                return cmp(x, key);
+			                })};
+		}
+
+		template<typename K, typename Compare>
+		[[nodiscard]] auto upper_bound(K const& key, Compare cmp) const -> iterator {
+			if (spilled()) {
+				return iterator{this, tree_.upper_bound(key, cmp)};
+			}
+			return iterator{this, std::partition_point(items_, items_ + count_, [&](T const& x) {
+				                return not cmp(key, x);
+			                })};
+		}
+
+		template<typename K, typename Compare>
+		[[nodiscard]] auto equal_range(K const& key, Compare cmp) const
+		   -> std::pair<iterator, iterator> {
+			return {lower_bound(key, cmp), upper_bound(key, cmp)};
+		}
+
+		template<typename K, typename Compare>
+		[[nodiscard]] auto find(K const& key, Compare cmp) const -> iterator {
+			auto const it = lower_bound(key, cmp);
+			return it == end() or cmp(key, *it) ? end() : it;
+		}
+
+		template<typename K, typename Compare>
+		[[nodiscard]] auto contains(K const& key, Compare cmp) const -> bool {
+			return find(key, cmp) != end();
+		}
+
+		// Puts value at rank i, before the element there, and returns an iterator to it.
+		auto insert(std::size_t i, T value, node_arena const& arena) -> iterator {
+			assert(i <= size());
+			if (spilled()) {
+				return iterator{this, tree_.insert(i, std::move(value))};
+			}
+			if (count_ == Inline) {
+				spill(i, std::move(value), arena);
+				return at(i);
+			}
+			if (i == count_) {
+				std::construct_at(items_ + i, std::move(value));
+			}
+			else {
+				std::construct_at(items_ + count_, std::move(items_[count_ - 1]));
+				std::move_backward(items_ + i, items_ + count_ - 1, items_ + count_);
+				items_[i] = std::move(value);
+			}
+			++count_;
+			return iterator{this, items_ + i};
+		}
+
+		auto insert(iterator pos, T value, node_arena const& arena) -> iterator {
+			return insert(pos.index(), std::move(value), arena);
+		}
+
+		auto push_back(T value, node_arena const& arena) -> void {
+			insert(size(), std::move(value), arena);
+		}
+
+		// As btree::own().
+		auto own(std::size_t i) -> void {
+			if (spilled()) {
+				tree_.own(i);
+			}
+		}
+
+		// Erases the element of rank i, throwing only as btree::erase() does. Erasing the last
+		// element of a tree brings the sequence back inside the object.
+		auto erase(std::size_t i) -> void {
+			assert(i < size());
+			if (spilled()) {
+				tree_.erase(i);
+				if (tree_.empty()) {
+					clear();
+				}
+				return;
+			}
+			std::move(items_ + i + 1, items_ + count_, items_ + i);
+			std::destroy_at(items_ + count_ - 1);
+			--count_;
+		}
+
+		auto erase(iterator pos) -> void {
+			erase(pos.index());
+		}
+
+		auto clear() noexcept -> void {
+			destroy();
+			count_ = 0;
+		}
+
+		class iterator {
+		public:
+			using value_type = T;
+			using reference = T const&;
+			using pointer = T const*;
+			using difference_type = std::ptrdiff_t;
+			using iterator_category = std::bidirectional_iterator_tag;
+
+			iterator() = default;
+
+			auto operator*() const -> T const& {
+				return item_ != nullptr ? *item_ : *node_;
+			}
+
+			auto operator->() const -> T const* {
+				return &**this;
+			}
+
+			auto operator++() -> iterator& {
+				if (item_ != nullptr) {
+					++item_;
+				}
+				else {
+					++node_;
+				}
+				return *this;
+			}
+
+			auto operator++(int) -> iterator {
+				auto old = *this;
+				++(*this);
+				return old;
+			}
+
+			auto operator--() -> iterator& {
+				if (item_ != nullptr) {
+					--item_;
+				}
+				else {
+					--node_;
+				}
+				return *this;
+			}
+
+			auto operator--(int) -> iterator {
+				auto old = *this;
+				--(*this);
+				return old;
+			}
+
+			// Two iterators into the array differ in item_ alone.
+			auto operator==(iterator const& other) const noexcept -> bool {
+				return item_ == other.item_ and (item_ != nullptr or node_ == other.node_);
+			}
+
+			// The element's rank.
+			[[nodiscard]] auto index() const noexcept -> std::size_t {
+				return item_ != nullptr ? static_cast<std::size_t>(item_ - owner_->items_)
+				                        : node_.index();
+			}
+
+			// Whether this is end(), without making one. Only for iterators from a small_tree.
+			[[nodiscard]] auto at_end() const noexcept -> bool {
+				return item_ != nullptr ? item_ == owner_->items_ + owner_->count_
+				                        : node_.index() == owner_->tree_.size();
+			}
+
+		private:
+			friend class small_tree;
+
+			small_tree const* owner_ = nullptr;
+			// Into the inline array, or null when the elements are in the tree.
+			T const* item_ = nullptr;
+			typename tree_type::iterator node_;
+
+			iterator(small_tree const* owner, T const* item)
+			: owner_{owner}
+			, item_{item} {}
+
+			iterator(small_tree const* owner, typename tree_type::iterator node)
+			: owner_{owner}
+			, node_{node} {}
+		};
+
+	private:
+		static constexpr auto spilled_count = ~std::uint32_t{0};
+
+		union {
+			tree_type tree_;
+			T items_[Inline];
+		};
+		// Elements in items_, or spilled_count once they are in tree_.
+		std::uint32_t count_ = 0;
+
+		// Moves the full array into a tree along with value at rank i. The tree is built from
+		// copies first, so that nothing changes if that throws.
+		auto spill(std::size_t i, T value, node_arena const& arena) -> void {
+			auto tree = tree_type{arena};
+			for (auto const& item : items_) {
+				tree.push_back(item);
+			}
+			tree.insert(i, std::move(value));
+			destroy();
+			std::construct_at(&tree_, std::move(tree));
+			count_ = spilled_count;
+		}
+
+		// Moves other's elements into this object, whose own have been destroyed, and leaves
+		// other empty.
+		auto take(small_tree& other) noexcept -> void {
+			if (other.spilled()) {
+				std::construct_at(&tree_, std::move(other.tree_));
+			}
+			else {
+				std::uninitialized_move_n(other.items_, other.count_, items_);
+			}
+			count_ = other.count_;
+			other.clear();
+		}
+
+		auto destroy() noexcept -> void {
+			if (spilled()) {
+				std::destroy_at(&tree_);
+			}
+			else {
+				std::destroy_n(items_, count_);
+			}
+		}
+	};
+} // namespace gdwg::detail
+
+#endif // GDWG_SMALL_TREE_HPP
@@ -0,0 +1,125 @@
+#ifndef GDWG_TEXT_SINK_HPP
+#define GDWG_TEXT_SINK_HPP
+
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <ios>
+#include <locale>
+#include <optional>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+namespace gdwg::detail {
+	template<typename T>
+	concept plain_integer = std::integral<T> and not std::same_as<T, bool>
+	                        and not std::same_as<T, char> and not std::same_as<T, signed char>
+	                        and not std::same_as<T, unsigned char> and not std::same_as<T, wchar_t>
+	                        and not std::same_as<T, char8_t> and not std::same_as<T, char16_t>
+	                        and not std::same_as<T, char32_t>;
+
+	// Formats values into a large buffer and hands it to the stream in a few big writes, instead
+	// of one formatted insertion per value. Strings are appended as they are, and numbers are
+	// formatted directly when the stream's flags and locale are the defaults, producing exactly
+	// what operator<< would; everything else goes through a string stream set up like the target.
+	// As with a run of insertions, the stream's width pads only the first thing put, and is reset
+	// to 0 as soon as the sink is made. flush() must be called once everything has been put.
+	class text_sink {
+	public:
+		explicit text_sink(std::ostream& os)
+		: os_{os}
+		, width_{os.width(0)}
+		, direct_{os.getloc() == std::locale::classic()
+		          and (os.flags() & ~(std::ios_base::dec | std::ios_base::skipws)) == 0} {
+			buffer_.reserve(buffer_size);
+		}
+
+		auto put(std::string_view text) -> void {
+			if (width_ != 0) {
+				put_formatted(text);
+				return;
+			}
+			buffer_.append(text);
+			flush_if_full();
+		}
+
+		auto put(char const* text) -> void {
+			put(std::string_view(text));
+		}
+
+		auto put(std::string const& text) -> void {
+			put(std::string_view(text));
+		}
+
+		template<typename T>
+		auto put(T const& value) -> void {
+			if constexpr (plain_integer<T> or std::floating_point<T>) {
+				if (direct_ and width_ == 0) {
+					put_number(value);
+					return;
+				}
+			}
+			put_formatted(value);
+		}
+
+		auto flush() -> void {
+			os_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+			buffer_.clear();
+		}
+
+	private:
+		static constexpr auto buffer_size = std::size_t{1} << 16;
+
+		std::ostream& os_;
+		// What is left of the stream's width: nothing once something has been put.
+		std::streamsize width_;
+		bool direct_;
+		std::string buffer_;
+		std::optional<std::ostringstream> fallback_;
+
+		// Inserts value into a string stream set up like the target, padded to width_.
+		template<typename T>
+		auto put_formatted(T const& value) -> void {
+			if (not fallback_) {
+				fallback_.emplace();
+				fallback_->copyfmt(os_);
+				fallback_->exceptions(std::ios_base::goodbit);
+			}
+			fallback_->str(std::string());
+			fallback_->width(std::exchange(width_, 0));
+			*fallback_ << value;
+			put(fallback_->view());
+		}
+
+		template<typename T>
+		auto put_number(T value) -> void {
+			char digits[64];
+			auto result = std::to_chars_result{};
+			if constexpr (std::floating_point<T>) {
+				// The default floatfield is printf's %g at the stream's precision.
+				result = std::to_chars(digits,
+				                       digits + sizeof(digits),
+				                       value,
+				                       std::chars_format::general,
+				                       static_cast<int>(os_.precision()));
+			}
+			else {
+				result = std::to_chars(digits, digits + sizeof(digits), value);
+			}
+			put(std::string_view(digits, static_cast<std::size_t>(result.ptr - digits)));
+		}
+
+		auto flush_if_full() -> void {
+			if (buffer_.size() >= buffer_size) {
+				flush();
+			}
+		}
+	};
+} // namespace gdwg::detail
+
+#endif // GDWG_TEXT_SINK_HPP
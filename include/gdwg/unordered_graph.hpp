@@ -0,0 +1,721 @@
+#ifndef GDWG_UNORDERED_GRAPH_HPP
+#define GDWG_UNORDERED_GRAPH_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "gdwg/hash.hpp"
+#include "gdwg/text_sink.hpp"
+
+namespace gdwg {
+	// The interface of graph, with nodes found through an open-addressing hash table instead of a
+	// search tree: looking a node up costs one Hash call and, usually, one KeyEqual call, instead
+	// of O(log n) comparisons of N. N needs Hash and KeyEqual but no ordering; E still needs <.
+	// Edges refer to their endpoints by slot, so replace_node() doesn't touch them.
+	//
+	// Orderings that graph guarantees and this doesn't: nodes(), connections(), incoming(),
+	// iteration and operator<< visit nodes in slot order rather than ascending by value. Slots
+	// are handed out in insertion order, except that a new node reuses an erased node's slot. A
+	// source's edges are grouped by destination in slot order; weights() and the edges between
+	// one pair of nodes are still ascending by weight. operator== doesn't depend on order.
+	// fingerprint() is computed as graph's is, from Hash instead of std::hash, so with the default
+	// Hash a graph and an unordered_graph holding the same nodes and edges have the same one.
+	//
+	// The ordered-only extras of graph are left out: node ids and what takes them (out_edges(),
+	// node(), id_of(), id_bound()), the views, freeze(), save(), load() and load_edge_list().
+	template<typename N,
+	         typename E,
+	         typename Hash = std::hash<N>,
+	         typename KeyEqual = std::equal_to<N>>
+	class unordered_graph {
+	public:
+		struct value_type {
+			N from;
+			N to;
+			E weight;
+		};
+
+		// As graph::reference: the edge's members by reference into the graph.
+		struct reference {
+			N const& from;
+			N const& to;
+			E const& weight;
+
+			operator value_type() const { // NOLINT(google-explicit-constructor)
+				return value_type{from, to, weight};
+			}
+		};
+
+		class iterator;
+
+		// Constructors
+		unordered_graph() = default;
+
+		unordered_graph(std::initializer_list<N> il)
+		: unordered_graph(il.begin(), il.end()) {}
+
+		template<typename InputIt>
+		unordered_graph(InputIt first, InputIt last) {
+			insert_nodes(first, last);
+		}
+
+		// Modifiers
+		// O(1) expected
+		auto insert_node(N const& value) -> bool {
+			auto const hash = hash_value(value);
+			if (locate(value, hash) != npos) {
+				return false;
+			}
+			add_node(value, hash);
+			return true;
+		}
+
+		// Inserts every value in [first, last) and returns how many weren't already nodes.
+		template<typename InputIt>
+		auto insert_nodes(InputIt first, InputIt last) -> std::size_t {
+			auto inserted = std::size_t{0};
+			for (; first != last; ++first) {
+				inserted += insert_node(*first) ? 1 : 0;
+			}
+			return inserted;
+		}
+
+		// Inserts every (from, to, weight) in [first, last) and returns how many weren't already
+		// edges. Nothing is inserted if an endpoint isn't a node.
+		template<typename InputIt>
+		auto insert_edges(InputIt first, InputIt last) -> std::size_t {
+			auto batch = std::vector<std::pair<std::pair<index_type, index_type>, E>>{};
+			for (; first != last; ++first) {
+				value_type const& e = *first;
+				auto const src = locate(e.from);
+				auto const dst = locate(e.to);
+				if (src == npos or dst == npos) {
+					throw std::runtime_error("Cannot call gdwg::unordered_graph<N, E>::insert_edges "
+					                         "when either src or dst node does not exist");
+				}
+				batch.push_back({{src, dst}, e.weight});
+			}
+			auto inserted = std::size_t{0};
+			for (auto const& [ends, weight] : batch) {
+				inserted += add_edge(ends.first, ends.second, weight) ? 1 : 0;
+			}
+			return inserted;
+		}
+
+		// O(1) expected + log(out-degree) + out-degree
+		auto insert_edge(N const& src, N const& dst, E const& weight) -> bool {
+			auto const s = locate(src);
+			auto const d = locate(dst);
+			if (s != npos and d != npos) {
+				return add_edge(s, d, weight);
+			}
+			throw std::runtime_error("Cannot call gdwg::unordered_graph<N, E>::insert_edge when "
+			                         "either src or dst node does not exist");
+		}
+
+		// O(1) expected + in-degree * log(in-degree) + log(out-degree) + out-degree of each of
+		// the node's sources + its own out-degree: edges refer to the slot, which keeps its place,
+		// so only their part of the fingerprint changes.
+		auto replace_node(N const& old_data, N const& new_data) -> bool {
+			auto const old_slot = locate(old_data);
+			if (old_slot == npos) {
+				throw std::runtime_error("Cannot call gdwg::unordered_graph<N, E>::replace_node on a "
+				                         "node that doesn't exist");
+			}
+			auto const hash = hash_value(new_data);
+			if (locate(new_data, hash) != npos) {
+				return false;
+			}
+			fingerprint_ -= node_fingerprint(old_slot);
+			table_erase(old_slot);
+			records_[old_slot].value = new_data;
+			records_[old_slot].hash = hash;
+			table_insert(old_slot);
+			fingerprint_ += node_fingerprint(old_slot);
+			return true;
+		}
+
+		// As erase_node(old_data), then log(out-degree) + out-degree for each edge moved.
+		auto merge_replace_node(N const& old_data, N const& new_data) -> void {
+			auto const old_slot = locate(old_data);
+			auto const new_slot = locate(new_data);
+			if (old_slot == npos or new_slot == npos) {
+				throw std::runtime_error("Cannot call gdwg::unordered_graph<N, E>::merge_replace_node "
+				                         "on old or new data if they don't exist in the graph");
+			}
+			if (old_slot == new_slot) {
+				return;
+			}
+			auto moved = std::vector<std::pair<std::pair<index_type, index_type>, E>>{};
+			for (auto const& e : records_[old_slot].out) {
+				moved.push_back({{new_slot, e.dst == old_slot ? new_slot : e.dst}, e.weight});
+			}
+			for (auto const s : sources(old_slot)) {
+				if (s != old_slot) {
+					auto const [first, last] = dst_range(s, old_slot);
+					for (auto it = first; it != last; ++it) {
+						moved.push_back({{s, new_slot}, it->weight});
+					}
+				}
+			}
+			remove_node(old_slot);
+			for (auto const& [ends, weight] : moved) {
+				add_edge(ends.first, ends.second, weight);
+			}
+		}
+
+		// O(1) expected + in-degree * log(in-degree) + the in-degree of each of the node's targets
+		// + log(out-degree) + out-degree of each of its sources: every edge into a target lists
+		// its source in a vector that is searched for it.
+		auto erase_node(N const& value) -> bool {
+			auto const slot = locate(value);
+			if (slot == npos) {
+				return false;
+			}
+			remove_node(slot);
+			return true;
+		}
+
+		// O(1) expected + log(out-degree) + out-degree + in-degree(dst)
+		auto erase_edge(N const& src, N const& dst, E const& weight) -> bool {
+			auto const s = locate(src);
+			auto const d = locate(dst);
+			if (s == npos or d == npos) {
+				throw std::runtime_error("Cannot call gdwg::unordered_graph<N, E>::erase_edge on src "
+				                         "or dst if they don't exist in the graph");
+			}
+			auto const pos = edge_position(s, d, weight);
+			if (pos == npos) {
+				return false;
+			}
+			remove_edge_at(s, pos);
+			return true;
+		}
+
+		// Erases every (from, to, weight) in [first, last) that is an edge and returns how many were
+		// erased. Nothing is erased if any endpoint isn't a node.
+		template<typename InputIt>
+		auto erase_edges(InputIt first, InputIt last) -> std::size_t {
+			auto batch = std::vector<std::pair<std::pair<index_type, index_type>, E>>{};
+			for (; first != last; ++first) {
+				value_type const& e = *first;
+				auto const src = locate(e.from);
+				auto const dst = locate(e.to);
+				if (src == npos or dst == npos) {
+					throw std::runtime_error("Cannot call gdwg::unordered_graph<N, E>::erase_edges on "
+					                         "src or dst if they don't exist in the graph");
+				}
+				batch.push_back({{src, dst}, e.weight});
+			}
+			auto erased = std::size_t{0};
+			for (auto const& [ends, weight] : batch) {
+				auto const pos = edge_position(ends.first, ends.second, weight);
+				if (pos != npos) {
+					remove_edge_at(ends.first, pos);
+					++erased;
+				}
+			}
+			return erased;
+		}
+
+		auto erase_edge(iterator i) -> iterator {
+			if (i == end() or i == iterator{}) {
+				return end();
+			}
+			remove_edge_at(i.src_, i.pos_);
+			return make_iterator(i.src_, i.pos_);
+		}
+
+		auto erase_edge(iterator i, iterator s) -> iterator {
+			// Erasing shifts the edges after i within its source, so count them first.
+			for (auto n = std::distance(i, s); n > 0; --n) {
+				i = erase_edge(i);
+			}
+			return i;
+		}
+
+		auto clear() noexcept -> void {
+			records_.clear();
+			free_.clear();
+			table_.clear();
+			num_nodes_ = 0;
+			num_edges_ = 0;
+			fingerprint_ = 0;
+		}
+
+		// Accessors
+		// O(1) expected
+		[[nodiscard]] auto is_node(N const& value) const -> bool {
+			return locate(value) != npos;
+		}
+
+		[[nodiscard]] auto empty() const -> bool {
+			return num_nodes_ == 0;
+		}
+
+		// O(1) expected + log(out-degree)
+		[[nodiscard]] auto is_connected(N const& src, N const& dst) const -> bool {
+			auto const s = locate(src);
+			auto const d = locate(dst);
+			if (s != npos and d != npos) {
+				auto const [first, last] = dst_range(s, d);
+				return first != last;
+			}
+			throw std::runtime_error("Cannot call gdwg::unordered_graph<N, E>::is_connected if src "
+			                         "or dst node don't exist in the graph");
+		}
+
+		// In slot order.
+		[[nodiscard]] auto nodes() const -> std::vector<N> {
+			auto v = std::vector<N>{};
+			v.reserve(num_nodes_);
+			for (auto const& record : records_) {
+				if (record.value) {
+					v.push_back(*record.value);
+				}
+			}
+			return v;
+		}
+
+		// O(1) expected + log(out-degree) + the result. Ascending, as in graph.
+		[[nodiscard]] auto weights(N const& src, N const& dst) const -> std::vector<E> {
+			auto const s = locate(src);
+			auto const d = locate(dst);
+			if (s != npos and d != npos) {
+				auto const [first, last] = dst_range(s, d);
+				auto v = std::vector<E>{};
+				for (auto it = first; it != last; ++it) {
+					v.push_back(it->weight);
+				}
+				return v;
+			}
+			throw std::runtime_error("Cannot call gdwg::unordered_graph<N, E>::weights if src or dst "
+			                         "node don't exist in the graph");
+		}
+
+		// O(1) expected + log(out-degree)
+		[[nodiscard]] auto find(N const& src, N const& dst, E const& weight) const -> iterator {
+			auto const s = locate(src);
+			auto const d = locate(dst);
+			if (s == npos or d == npos) {
+				return end();
+			}
+			auto const pos = edge_position(s, d, weight);
+			return pos == npos ? end() : iterator{this, s, pos};
+		}
+
+		// O(1) expected + out-degree. One per edge, in slot order.
+		[[nodiscard]] auto connections(N const& src) const -> std::vector<N> {
+			auto const s = locate(src);
+			if (s != npos) {
+				auto v = std::vector<N>{};
+				v.reserve(records_[s].out.size());
+				for (auto const& e : records_[s].out) {
+					v.push_back(*records_[e.dst].value);
+				}
+				return v;
+			}
+			throw std::runtime_error("Cannot call gdwg::unordered_graph<N, E>::connections if src "
+			                         "doesn't exist in the graph");
+		}
+
+		// O(1) expected + in-degree * log(in-degree). One per edge, in slot order.
+		[[nodiscard]] auto incoming(N const& dst) const -> std::vector<N> {
+			auto const d = locate(dst);
+			if (d != npos) {
+				auto in = records_[d].in;
+				std::sort(in.begin(), in.end());
+				auto v = std::vector<N>{};
+				v.reserve(in.size());
+				for (auto const s : in) {
+					v.push_back(*records_[s].value);
+				}
+				return v;
+			}
+			throw std::runtime_error("Cannot call gdwg::unordered_graph<N, E>::incoming if dst "
+			                         "doesn't exist in the graph");
+		}
+
+		// As graph::fingerprint(). O(1)
+		[[nodiscard]] auto fingerprint() const noexcept -> std::uint64_t {
+			return fingerprint_;
+		}
+
+		// Iterator
+		[[nodiscard]] auto begin() const -> iterator {
+			return make_iterator(0, 0);
+		}
+
+		[[nodiscard]] auto end() const -> iterator {
+			return iterator{this, static_cast<index_type>(records_.size()), 0};
+		}
+
+		// Comparison
+		// n + e * log(out-degree), whatever order either graph holds things in.
+		[[nodiscard]] auto operator==(unordered_graph const& other) const -> bool {
+			if (num_nodes_ != other.num_nodes_ or num_edges_ != other.num_edges_) {
+				return false;
+			}
+			// Both hold distinct edges and the same number of them, so it is enough that every
+			// edge here is one there.
+			auto slot_there = std::vector<index_type>(records_.size(), npos);
+			for (auto i = index_type{0}; i < records_.size(); ++i) {
+				if (records_[i].value) {
+					slot_there[i] = other.locate(*records_[i].value);
+					if (slot_there[i] == npos) {
+						return false;
+					}
+				}
+			}
+			for (auto i = index_type{0}; i < records_.size(); ++i) {
+				auto const& out = records_[i].out;
+				if (records_[i].value and out.size() != other.records_[slot_there[i]].out.size()) {
+					return false;
+				}
+				for (auto const& e : out) {
+					if (other.edge_position(slot_there[i], slot_there[e.dst], e.weight) == npos) {
+						return false;
+					}
+				}
+			}
+			return true;
+		}
+
+	private:
+		using index_type = std::uint32_t;
+		static constexpr auto npos = std::numeric_limits<index_type>::max();
+
+		struct out_edge {
+			index_type dst;
+			E weight;
+		};
+
+		struct node_record {
+			// Empty once the node is erased, until the slot is reused.
+			std::optional<N> value;
+			std::size_t hash = 0;
+			// Sorted by (dst, weight).
+			std::vector<out_edge> out;
+			// The source of every edge into this node, unsorted, once per edge.
+			std::vector<index_type> in;
+		};
+
+		std::vector<node_record> records_;
+		std::vector<index_type> free_;
+		// Slots of records_, or npos where empty. Linear probing, at most half full, and erasing
+		// shifts the rest of the probe run back, so there are no tombstones.
+		std::vector<index_type> table_;
+		std::size_t num_nodes_ = 0;
+		std::size_t num_edges_ = 0;
+		// Sum of node_hash() over the nodes and edge_hash() over the edges.
+		std::uint64_t fingerprint_ = 0;
+		[[no_unique_address]] Hash hasher_;
+		[[no_unique_address]] KeyEqual equal_;
+
+		[[nodiscard]] auto hash_value(N const& value) const -> std::size_t {
+			return static_cast<std::size_t>(hasher_(value));
+		}
+
+		// A node's part of the fingerprint, as graph's node_record::hash.
+		[[nodiscard]] auto node_hash(index_type slot) const noexcept -> std::uint64_t {
+			return detail::mix(static_cast<std::uint64_t>(records_[slot].hash));
+		}
+
+		// As graph's edge_hash().
+		[[nodiscard]] auto edge_hash(index_type src, index_type dst, E const& weight) const noexcept
+		   -> std::uint64_t {
+			return detail::mix(node_hash(src) + detail::mix(node_hash(dst) ^ detail::hash_of(weight)));
+		}
+
+		// Everything in the fingerprint that depends on the node in slot: its own hash and its
+		// edges' both ways.
+		[[nodiscard]] auto node_fingerprint(index_type slot) const -> std::uint64_t {
+			auto sum = node_hash(slot);
+			for (auto const& e : records_[slot].out) {
+				sum += edge_hash(slot, e.dst, e.weight);
+			}
+			for (auto const s : sources(slot)) {
+				if (s != slot) {
+					auto const [first, last] = dst_range(s, slot);
+					for (auto it = first; it != last; ++it) {
+						sum += edge_hash(s, slot, it->weight);
+					}
+				}
+			}
+			return sum;
+		}
+
+		// Where a hash starts probing. Hashes are mixed first since std::hash is often the
+		// identity, which would make runs of consecutive integers collide in long probe runs.
+		[[nodiscard]] auto home(std::size_t hash) const noexcept -> std::size_t {
+			return static_cast<std::size_t>(detail::mix(hash)) & (table_.size() - 1);
+		}
+
+		[[nodiscard]] auto locate(N const& value) const -> index_type {
+			return locate(value, hash_value(value));
+		}
+
+		// The slot holding value, or npos.
+		[[nodiscard]] auto locate(N const& value, std::size_t hash) const -> index_type {
+			if (table_.empty()) {
+				return npos;
+			}
+			for (auto i = home(hash);; i = (i + 1) & (table_.size() - 1)) {
+				auto const slot = table_[i];
+				if (slot == npos) {
+					return npos;
+				}
+				auto const& record = records_[slot];
+				if (record.hash == hash and equal_(*record.value, value)) {
+					return slot;
+				}
+			}
+		}
+
+		auto table_insert(index_type slot) -> void {
+			auto i = home(records_[slot].hash);
+			while (table_[i] != npos) {
+				i = (i + 1) & (table_.size() - 1);
+			}
+			table_[i] = slot;
+		}
+
+		auto table_erase(index_type slot) -> void {
+			auto const mask = table_.size() - 1;
+			auto i = home(records_[slot].hash);
+			while (table_[i] != slot) {
+				i = (i + 1) & mask;
+			}
+			// Moves back every later entry of the run whose home isn't between the hole and it.
+			for (auto j = (i + 1) & mask; table_[j] != npos; j = (j + 1) & mask) {
+				auto const k = home(records_[table_[j]].hash);
+				if (((j - k) & mask) >= ((j - i) & mask)) {
+					table_[i] = table_[j];
+					i = j;
+				}
+			}
+			table_[i] = npos;
+		}
+
+		auto add_node(N const& value, std::size_t hash) -> index_type {
+			if (2 * (num_nodes_ + 1) > table_.size()) {
+				auto const old_table = std::exchange(table_, {});
+				table_.assign(std::max(std::size_t{16}, 2 * old_table.size()), npos);
+				for (auto const slot : old_table) {
+					if (slot != npos) {
+						table_insert(slot);
+					}
+				}
+			}
+			auto slot = npos;
+			if (free_.empty()) {
+				slot = static_cast<index_type>(records_.size());
+				records_.push_back(node_record{value, hash, {}, {}});
+			}
+			else {
+				slot = free_.back();
+				free_.pop_back();
+				records_[slot].value = value;
+				records_[slot].hash = hash;
+			}
+			table_insert(slot);
+			++num_nodes_;
+			fingerprint_ += node_hash(slot);
+			return slot;
+		}
+
+		auto remove_node(index_type slot) -> void {
+			fingerprint_ -= node_fingerprint(slot);
+			auto& record = records_[slot];
+			for (auto const& e : record.out) {
+				if (e.dst != slot) {
+					remove_one(records_[e.dst].in, slot);
+				}
+			}
+			num_edges_ -= record.out.size();
+			for (auto const s : sources(slot)) {
+				if (s != slot) {
+					auto const [first, last] = dst_range(s, slot);
+					num_edges_ -= static_cast<std::size_t>(last - first);
+					records_[s].out.erase(first, last);
+				}
+			}
+			table_erase(slot);
+			record.value.reset();
+			record.out.clear();
+			record.in.clear();
+			free_.push_back(slot);
+			--num_nodes_;
+		}
+
+		static auto edge_less(out_edge const& x, out_edge const& y) -> bool {
+			return x.dst < y.dst or (x.dst == y.dst and x.weight < y.weight);
+		}
+
+		auto add_edge(index_type src, index_type dst, E const& weight) -> bool {
+			auto& out = records_[src].out;
+			auto const key = out_edge{dst, weight};
+			auto const it = std::lower_bound(out.begin(), out.end(), key, edge_less);
+			if (it != out.end() and not edge_less(key, *it)) {
+				return false;
+			}
+			out.insert(it, key);
+			records_[dst].in.push_back(src);
+			++num_edges_;
+			fingerprint_ += edge_hash(src, dst, weight);
+			return true;
+		}
+
+		auto remove_edge_at(index_type src, std::size_t pos) -> void {
+			auto& out = records_[src].out;
+			fingerprint_ -= edge_hash(src, out[pos].dst, out[pos].weight);
+			remove_one(records_[out[pos].dst].in, src);
+			out.erase(out.begin() + static_cast<std::ptrdiff_t>(pos));
+			--num_edges_;
+		}
+
+		static auto remove_one(std::vector<index_type>& slots, index_type slot) -> void {
+			auto const it = std::find(slots.begin(), slots.end(), slot);
+			*it = slots.back();
+			slots.pop_back();
+		}
+
+		// Position of the edge in src's out-edges, or npos.
+		[[nodiscard]] auto edge_position(index_type src, index_type dst, E const& weight) const
+		   -> std::size_t {
+			auto const& out = records_[src].out;
+			auto const key = out_edge{dst, weight};
+			auto const it = std::lower_bound(out.begin(), out.end(), key, edge_less);
+			if (it == out.end() or edge_less(key, *it)) {
+				return npos;
+			}
+			return static_cast<std::size_t>(it - out.begin());
+		}
+
+		[[nodiscard]] auto dst_range(index_type src, index_type dst) const {
+			auto const& out = records_[src].out;
+			auto const by_dst = [](out_edge const& e, index_type d) { return e.dst < d; };
+			auto const first = std::lower_bound(out.begin(), out.end(), dst, by_dst);
+			auto last = first;
+			while (last != out.end() and last->dst == dst) {
+				++last;
+			}
+			return std::pair{first, last};
+		}
+
+		// The distinct sources of edges into slot, in slot order.
+		[[nodiscard]] auto sources(index_type slot) const -> std::vector<index_type> {
+			auto v = records_[slot].in;
+			std::sort(v.begin(), v.end());
+			v.erase(std::unique(v.begin(), v.end()), v.end());
+			return v;
+		}
+
+		// The edge at (src, pos), or the next one after it if src has fewer edges.
+		[[nodiscard]] auto make_iterator(index_type src, std::size_t pos) const -> iterator {
+			while (src < records_.size() and pos >= records_[src].out.size()) {
+				++src;
+				pos = 0;
+			}
+			return iterator{this, src, pos};
+		}
+
+		// Hidden Friend: Extractor
+		// As graph's, with nodes in slot order.
+		friend auto operator<<(std::ostream& os, unordered_graph const& g) -> std::ostream& {
+			auto out = detail::text_sink(os);
+			for (auto const& record : g.records_) {
+				if (not record.value) {
+					continue;
+				}
+				out.put(*record.value);
+				out.put(" (\n");
+				for (auto const& e : record.out) {
+					out.put("  ");
+					out.put(*g.records_[e.dst].value);
+					out.put(" | ");
+					out.put(e.weight);
+					out.put("\n");
+				}
+				out.put(")\n");
+			}
+			out.flush();
+			return os;
+		}
+
+	public:
+		class iterator {
+		public:
+			using value_type = unordered_graph::value_type;
+			using reference = unordered_graph::reference;
+			using pointer = void;
+			using difference_type = std::ptrdiff_t;
+			using iterator_category = std::bidirectional_iterator_tag;
+
+			// Iterator constructor
+			iterator() = default;
+
+			// Iterator source
+			auto operator*() const -> reference {
+				auto const& e = g_->records_[src_].out[pos_];
+				return reference{*g_->records_[src_].value, *g_->records_[e.dst].value, e.weight};
+			}
+
+			// Iterator traversal
+			auto operator++() -> iterator& {
+				*this = g_->make_iterator(src_, pos_ + 1);
+				return *this;
+			}
+
+			auto operator++(int) -> iterator {
+				auto old = *this;
+				++(*this);
+				return old;
+			}
+
+			auto operator--() -> iterator& {
+				while (pos_ == 0) {
+					--src_;
+					pos_ = g_->records_[src_].out.size();
+				}
+				--pos_;
+				return *this;
+			}
+
+			auto operator--(int) -> iterator {
+				auto old = *this;
+				--(*this);
+				return old;
+			}
+
+			// Iterator comparison
+			auto operator==(iterator const& other) const -> bool {
+				return g_ == other.g_ and src_ == other.src_ and pos_ == other.pos_;
+			}
+
+		private:
+			friend class unordered_graph;
+
+			unordered_graph const* g_ = nullptr;
+			index_type src_ = 0;
+			std::size_t pos_ = 0;
+
+			iterator(unordered_graph const* g, index_type src, std::size_t pos)
+			: g_{g}
+			, src_{src}
+			, pos_{pos} {}
+		};
+	};
+} // namespace gdwg
+
+#endif // GDWG_UNORDERED_GRAPH_HPP
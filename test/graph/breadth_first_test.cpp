@@ -0,0 +1,85 @@
+#include "gdwg/breadth_first.hpp"
+#include "gdwg/graph.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <queue>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+	// Plain single-threaded breadth-first search to check against.
+	template<typename N, typename E>
+	auto expected_depths(gdwg::frozen_graph<N, E> const& g, std::size_t source)
+	   -> std::vector<std::uint32_t> {
+		auto depth = std::vector<std::uint32_t>(g.num_nodes(), gdwg::breadth_first<N, E>::unreached);
+		auto queue = std::queue<std::size_t>{};
+		depth[source] = 0;
+		queue.push(source);
+		while (not queue.empty()) {
+			auto const u = queue.front();
+			queue.pop();
+			for (auto const v : g.targets(u)) {
+				if (depth[v] == gdwg::breadth_first<N, E>::unreached) {
+					depth[v] = depth[u] + 1;
+					queue.push(v);
+				}
+			}
+		}
+		return depth;
+	}
+} // namespace
+
+TEST_CASE("Breadth-first depths") {
+	auto g = gdwg::graph<std::string, int>{"a", "b", "c", "d", "e"};
+	g.insert_edge("a", "b", 1);
+	g.insert_edge("a", "b", 2);
+	g.insert_edge("b", "c", 1);
+	g.insert_edge("c", "a", 1);
+	g.insert_edge("c", "d", 1);
+	g.insert_edge("e", "a", 1);
+	auto const frozen = g.freeze();
+	auto const bfs = gdwg::breadth_first(frozen, 2);
+	auto constexpr unreached = decltype(bfs)::unreached;
+
+	SECTION("hops from the source, by node index") {
+		CHECK(bfs.depths(frozen.find_index("a"))
+		      == std::vector<std::uint32_t>{0, 1, 2, 3, unreached});
+		CHECK(bfs.depths(frozen.find_index("d"))
+		      == std::vector<std::uint32_t>{unreached, unreached, unreached, 0, unreached});
+	}
+
+	SECTION("a source that isn't a node") {
+		CHECK_THROWS_MATCHES(bfs.depths(frozen.num_nodes()),
+		                     std::runtime_error,
+		                     Catch::Matchers::Message("Cannot call gdwg::breadth_first<N, E>::depths "
+		                                              "if source isn't a node of the graph"));
+	}
+}
+
+TEST_CASE("Breadth-first depths agree with a plain search") {
+	// A few hubs and many leaves, so the search goes bottom-up for its middle levels.
+	auto rng = std::mt19937(7);
+	auto const num_nodes = 5000;
+	auto node = std::uniform_int_distribution<int>(0, num_nodes - 1);
+	auto g = gdwg::graph<int, int, gdwg::layout::adjacency>{};
+	for (auto n = 0; n < num_nodes; ++n) {
+		g.insert_node(n);
+	}
+	for (auto n = 0; n < num_nodes; ++n) {
+		auto const degree = 1 + num_nodes / (4 * (n + 1));
+		for (auto d = 0; d < degree; ++d) {
+			g.insert_edge(n, node(rng), 0);
+		}
+	}
+	auto const frozen = g.freeze();
+	auto const threads = GENERATE(1U, 2U, 4U);
+	auto const bfs = gdwg::breadth_first(frozen, threads);
+	for (auto const source : {std::size_t{0}, std::size_t{17}, std::size_t{4999}}) {
+		CHECK(bfs.depths(source) == expected_depths(frozen, source));
+	}
+}
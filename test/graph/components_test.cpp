@@ -0,0 +1,197 @@
+#include "gdwg/components.hpp"
+#include "gdwg/graph.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+	// Depth-first over edges in both directions, naming each component by its least node.
+	template<typename N, typename E>
+	auto expected_components(gdwg::frozen_graph<N, E> const& g) -> std::vector<std::uint32_t> {
+		auto neighbours = std::vector<std::vector<std::uint32_t>>(g.num_nodes());
+		for (auto u = std::size_t{0}; u < g.num_nodes(); ++u) {
+			for (auto const v : g.targets(u)) {
+				neighbours[u].push_back(v);
+				neighbours[v].push_back(static_cast<std::uint32_t>(u));
+			}
+		}
+		auto const none = static_cast<std::uint32_t>(g.num_nodes());
+		auto component = std::vector<std::uint32_t>(g.num_nodes(), none);
+		for (auto root = std::uint32_t{0}; root < g.num_nodes(); ++root) {
+			if (component[root] != none) {
+				continue;
+			}
+			auto stack = std::vector<std::uint32_t>{root};
+			component[root] = root;
+			while (not stack.empty()) {
+				auto const u = stack.back();
+				stack.pop_back();
+				for (auto const v : neighbours[u]) {
+					if (component[v] == none) {
+						component[v] = root;
+						stack.push_back(v);
+					}
+				}
+			}
+		}
+		return component;
+	}
+} // namespace
+
+TEST_CASE("Weakly connected components") {
+	auto g = gdwg::graph<std::string, int>{"a", "b", "c", "d", "e", "f"};
+	g.insert_edge("b", "a", 1);
+	g.insert_edge("c", "b", 1);
+	g.insert_edge("d", "f", 1);
+	g.insert_edge("f", "f", 1);
+	auto const frozen = g.freeze();
+	CHECK(gdwg::weakly_connected_components(frozen, 2)
+	      == std::vector<std::uint32_t>{0, 0, 0, 3, 4, 3});
+	CHECK(gdwg::weakly_connected_components(gdwg::frozen_graph<int, int>{}).empty());
+}
+
+TEST_CASE("Weakly connected components agree with a plain search") {
+	// Sparse enough to leave many components, some joined only against the edges' direction.
+	auto rng = std::mt19937(11);
+	auto const num_nodes = 5000;
+	auto node = std::uniform_int_distribution<int>(0, num_nodes - 1);
+	auto g = gdwg::graph<int, int, gdwg::layout::adjacency>{};
+	for (auto n = 0; n < num_nodes; ++n) {
+		g.insert_node(n);
+	}
+	for (auto i = 0; i < num_nodes / 2; ++i) {
+		g.insert_edge(node(rng), node(rng), 0);
+	}
+	for (auto n = 0; n < 50; ++n) {
+		for (auto d = 0; d < 40; ++d) {
+			g.insert_edge(n, node(rng), 0);
+		}
+	}
+	auto const frozen = g.freeze();
+	auto const threads = GENERATE(1U, 2U, 4U);
+	CHECK(gdwg::weakly_connected_components(frozen, threads) == expected_components(frozen));
+}
+
+TEMPLATE_TEST_CASE("Strongly connected components",
+                   "",
+                   gdwg::layout::edge_tree,
+                   gdwg::layout::adjacency) {
+	auto g = gdwg::graph<std::string, int, TestType>{"a", "b", "c", "d", "e", "f"};
+	g.insert_edge("a", "b", 1);
+	g.insert_edge("b", "c", 1);
+	g.insert_edge("c", "a", 1);
+	g.insert_edge("c", "d", 4);
+	g.insert_edge("b", "d", 2);
+	g.insert_edge("b", "d", 3);
+	g.insert_edge("d", "e", 1);
+	g.insert_edge("e", "d", 1);
+	g.insert_edge("f", "f", 1);
+	auto const component = [&g](auto const& result, std::string const& value) {
+		return result.component[static_cast<std::size_t>(*g.id_of(value))];
+	};
+
+	SECTION("components and the edges between them") {
+		auto const result = gdwg::strongly_connected_components(g);
+		auto const abc = component(result, "a");
+		auto const de = component(result, "d");
+		CHECK(component(result, "b") == abc);
+		CHECK(component(result, "c") == abc);
+		CHECK(component(result, "e") == de);
+		CHECK(abc < de);
+		CHECK(component(result, "f") != abc);
+		CHECK(component(result, "f") != de);
+		CHECK(result.dag.nodes() == std::vector<std::uint32_t>{0, 1, 2});
+		CHECK(result.dag.weights(abc, de) == std::vector<int>{2, 3, 4});
+		CHECK(std::distance(result.dag.begin(), result.dag.end()) == 3);
+	}
+
+	SECTION("erased nodes have no component") {
+		auto const b = *g.id_of("b");
+		g.erase_node("b");
+		auto const result = gdwg::strongly_connected_components(g);
+		CHECK(result.component[static_cast<std::size_t>(b)] == result.no_component);
+		CHECK(component(result, "a") != component(result, "c"));
+		CHECK(result.dag.nodes().size() == 4);
+	}
+
+	SECTION("an empty graph") {
+		auto const result = gdwg::strongly_connected_components(gdwg::graph<int, int, TestType>{});
+		CHECK(result.component.empty());
+		CHECK(result.dag.empty());
+	}
+}
+
+TEST_CASE("Strongly connected components of a long chain") {
+	// Deep enough to overflow the stack of a recursive search.
+	auto const length = 200000;
+	auto g = gdwg::graph<int, int, gdwg::layout::adjacency>{};
+	auto edges = std::vector<gdwg::graph<int, int, gdwg::layout::adjacency>::value_type>{};
+	for (auto n = 0; n < length; ++n) {
+		g.insert_node(n);
+		if (n > 0) {
+			edges.push_back({n - 1, n, 0});
+		}
+	}
+	g.insert_edges(edges.begin(), edges.end());
+
+	auto const chain = gdwg::strongly_connected_components(g);
+	CHECK(chain.dag.nodes().size() == length);
+	CHECK(chain.component[static_cast<std::size_t>(*g.id_of(0))] == 0);
+
+	g.insert_edge(length - 1, 0, 0);
+	auto const cycle = gdwg::strongly_connected_components(g);
+	CHECK(cycle.dag.nodes() == std::vector<std::uint32_t>{0});
+	CHECK(cycle.dag.begin() == cycle.dag.end());
+}
+
+TEST_CASE("Strongly connected components agree with reachability") {
+	auto rng = std::mt19937(5);
+	auto const num_nodes = 60;
+	auto node = std::uniform_int_distribution<int>(0, num_nodes - 1);
+	auto g = gdwg::graph<int, int>{};
+	for (auto n = 0; n < num_nodes; ++n) {
+		g.insert_node(n);
+	}
+	for (auto i = 0; i < 90; ++i) {
+		g.insert_edge(node(rng), node(rng), 0);
+	}
+
+	auto reach = std::vector<std::vector<bool>>(num_nodes, std::vector<bool>(num_nodes));
+	for (auto const& [from, to, weight] : g) {
+		reach[static_cast<std::size_t>(from)][static_cast<std::size_t>(to)] = true;
+	}
+	for (auto k = std::size_t{0}; k < num_nodes; ++k) {
+		reach[k][k] = true;
+		for (auto i = std::size_t{0}; i < num_nodes; ++i) {
+			for (auto j = std::size_t{0}; j < num_nodes; ++j) {
+				if (reach[i][k] and reach[k][j]) {
+					reach[i][j] = true;
+				}
+			}
+		}
+	}
+
+	auto const result = gdwg::strongly_connected_components(g);
+	auto const component = [&](int n) {
+		return result.component[static_cast<std::size_t>(*g.id_of(n))];
+	};
+	for (auto i = 0; i < num_nodes; ++i) {
+		for (auto j = 0; j < num_nodes; ++j) {
+			auto const both = reach[static_cast<std::size_t>(i)][static_cast<std::size_t>(j)]
+			                  and reach[static_cast<std::size_t>(j)][static_cast<std::size_t>(i)];
+			CHECK((component(i) == component(j)) == both);
+			if (reach[static_cast<std::size_t>(i)][static_cast<std::size_t>(j)]) {
+				CHECK(component(i) <= component(j));
+			}
+		}
+	}
+	for (auto const& [from, to, weight] : result.dag) {
+		CHECK(from < to);
+	}
+}
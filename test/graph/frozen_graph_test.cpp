@@ -0,0 +1,91 @@
+#include "gdwg/graph.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+TEST_CASE("Freeze") {
+	auto g = gdwg::graph<std::string, int>{"a", "b", "c", "d"};
+	g.insert_edge("a", "b", 3);
+	g.insert_edge("a", "b", 1);
+	g.insert_edge("a", "a", 2);
+	g.insert_edge("c", "a", 5);
+	g.insert_edge("c", "d", 4);
+	auto const f = g.freeze();
+
+	SECTION("accessors match the graph") {
+		CHECK(f.nodes() == g.nodes());
+		CHECK(f.is_node("d"));
+		CHECK(!f.is_node("z"));
+		CHECK(f.connections("a") == g.connections("a"));
+		CHECK(f.connections("b").empty());
+		CHECK(f.weights("a", "b") == std::vector<int>{1, 3});
+		CHECK(f.is_connected("c", "d"));
+		CHECK(!f.is_connected("d", "c"));
+		CHECK_THROWS(f.connections("z"));
+		CHECK_THROWS(f.is_connected("a", "z"));
+	}
+
+	SECTION("find") {
+		auto const it = f.find("c", "a", 5);
+		REQUIRE(it != f.end());
+		CHECK((*it).from == "c");
+		CHECK((*it).to == "a");
+		CHECK(f.find("c", "a", 6) == f.end());
+		CHECK(f.find("z", "a", 5) == f.end());
+	}
+
+	SECTION("iteration visits the same edges in the same order") {
+		auto expected = std::vector<std::string>{};
+		for (auto const& [from, to, weight] : g) {
+			expected.push_back(from + to + std::to_string(weight));
+		}
+		auto forward = std::vector<std::string>{};
+		for (auto const& [from, to, weight] : f) {
+			forward.push_back(from + to + std::to_string(weight));
+		}
+		CHECK(forward == expected);
+
+		auto backward = std::vector<std::string>{};
+		for (auto it = f.end(); it != f.begin();) {
+			--it;
+			backward.insert(backward.begin(), (*it).from + (*it).to + std::to_string((*it).weight));
+		}
+		CHECK(backward == expected);
+	}
+
+	SECTION("prints like the graph") {
+		auto from_graph = std::ostringstream{};
+		auto from_frozen = std::ostringstream{};
+		from_graph << g;
+		from_frozen << f;
+		CHECK(from_frozen.str() == from_graph.str());
+	}
+
+	SECTION("is independent of the graph") {
+		g.erase_node("a");
+		CHECK(f.weights("a", "b") == std::vector<int>{1, 3});
+	}
+
+	SECTION("index access") {
+		auto const a = f.find_index("a");
+		auto const c = f.find_index("c");
+		CHECK(f.num_nodes() == 4);
+		CHECK(f.num_edges() == 5);
+		CHECK(f.find_index("z") == f.num_nodes());
+		CHECK(f.out_degree(a) == 3);
+		CHECK(f.node(f.targets(c)[1]) == "d");
+		CHECK(f.edge_weights(c)[1] == 4);
+	}
+}
+
+TEST_CASE("Freeze empty graph") {
+	auto const f = gdwg::graph<int, int>{}.freeze();
+	CHECK(f.empty());
+	CHECK(f.begin() == f.end());
+	auto const g = gdwg::graph<int, int>{1, 2}.freeze();
+	CHECK(g.begin() == g.end());
+	CHECK(g.connections(1).empty());
+}
@@ -1,5 +1,8 @@
 #include "gdwg/graph.hpp"
 #include <catch2/catch.hpp>
+#include <algorithm>
+#include <ranges>
+#include <string>
 #include <vector>
 
 TEST_CASE("Is node") {
@@ -91,4 +94,119 @@ TEST_CASE("Connection") {
 	CHECK(g1.connections(1) == std::vector<int>{2,2});
 
 	CHECK_THROWS(g1.connections(99));
-}
\ No newline at end of file
+}
+
+TEST_CASE("Neighbour queries only see edges of their own source") {
+	auto g = gdwg::graph<std::string, int>{"a", "b", "c", "d"};
+	g.insert_edge("a", "b", 1);
+	g.insert_edge("b", "a", 2);
+	g.insert_edge("b", "c", 3);
+	g.insert_edge("b", "c", 4);
+	g.insert_edge("c", "a", 5);
+
+	CHECK(g.connections("b") == std::vector<std::string>{"a", "c", "c"});
+	CHECK(g.connections("d").empty());
+	CHECK(g.weights("b", "c") == std::vector<int>{3, 4});
+	CHECK(g.weights("a", "c").empty());
+	CHECK(g.is_connected("c", "a"));
+	CHECK(!g.is_connected("a", "c"));
+	CHECK(!g.is_connected("d", "d"));
+}
+
+TEST_CASE("Incoming") {
+	auto g = gdwg::graph<int, int>{1, 2, 3, 4};
+	g.insert_edge(2, 1, 7);
+	g.insert_edge(3, 1, 6);
+	g.insert_edge(2, 1, 5);
+	g.insert_edge(1, 1, 9);
+	g.insert_edge(1, 2, 8);
+
+	CHECK(g.incoming(1) == std::vector<int>{1, 2, 2, 3});
+	CHECK(g.incoming(2) == std::vector<int>{1});
+	CHECK(g.incoming(4).empty());
+
+	CHECK_THROWS(g.incoming(99));
+}
+
+TEST_CASE("Node ids") {
+	using graph = gdwg::graph<std::string, int>;
+	auto g = graph{"a", "b", "c"};
+	g.insert_edge("a", "b", 1);
+	g.insert_edge("a", "c", 2);
+	g.insert_edge("c", "a", 3);
+
+	auto const a = g.id_of("a").value();
+	auto const b = g.id_of("b").value();
+	auto const c = g.id_of("c").value();
+	CHECK(!g.id_of("z").has_value());
+	CHECK(g.id_bound() == 3);
+	CHECK(g.node(b) == "b");
+
+	SECTION("id queries agree with value queries") {
+		CHECK(g.connections(a) == std::vector<graph::node_id>{b, c});
+		CHECK(g.incoming(a) == std::vector<graph::node_id>{c});
+		CHECK(g.is_connected(c, a));
+		CHECK(!g.is_connected(b, a));
+		CHECK(g.weights(a, c) == std::vector<int>{2});
+		CHECK(g.insert_edge(b, a, 4));
+		CHECK(g.weights("b", "a") == std::vector<int>{4});
+	}
+
+	SECTION("erased ids are reused and copies keep ids") {
+		CHECK(g.erase_node("b"));
+		CHECK(!g.is_node(b));
+		CHECK_THROWS(g.node(b));
+		CHECK_THROWS(g.connections(b));
+		CHECK(g.insert_node("d"));
+		CHECK(g.id_of("d") == b);
+		CHECK(g.id_bound() == 3);
+
+		auto const copy = g;
+		CHECK(copy.id_of("a") == a);
+		CHECK(copy.id_of("d") == b);
+		CHECK(copy.connections(a) == std::vector<graph::node_id>{c});
+	}
+
+	SECTION("the most recently freed id is reused first") {
+		CHECK(g.erase_node("a"));
+		CHECK(g.erase_node("c"));
+		CHECK(g.insert_node("x"));
+		CHECK(g.id_of("x") == c);
+		CHECK(g.insert_node("y"));
+		CHECK(g.id_of("y") == a);
+		CHECK(g.id_bound() == 3);
+	}
+}
+
+TEST_CASE("Views") {
+	auto g = gdwg::graph<std::string, int>{"a", "b", "c"};
+	g.insert_edge("a", "b", 2);
+	g.insert_edge("a", "b", 1);
+	g.insert_edge("a", "c", 3);
+	g.insert_edge("b", "a", 4);
+
+	SECTION("Nodes") {
+		auto const v = g.nodes_view();
+		CHECK(std::ranges::equal(v, g.nodes()));
+		CHECK(&*v.begin() == &*g.nodes_view().begin());
+		CHECK(std::ranges::equal(v | std::views::reverse | std::views::take(2),
+		                         std::vector<std::string>{"c", "b"}));
+	}
+
+	SECTION("Connections") {
+		CHECK(std::ranges::equal(g.connections_view("a"), g.connections("a")));
+		CHECK(std::ranges::empty(g.connections_view("c")));
+		CHECK(std::ranges::any_of(g.connections_view("b"), [](auto const& n) { return n == "a"; }));
+		CHECK_THROWS_WITH(g.connections_view("d"),
+		                  "Cannot call gdwg::graph<N, E>::connections_view if src doesn't exist in "
+		                  "the graph");
+	}
+
+	SECTION("Weights") {
+		CHECK(std::ranges::equal(g.weights_view("a", "b"), std::vector<int>{1, 2}));
+		CHECK(std::ranges::empty(g.weights_view("b", "c")));
+		CHECK_THROWS_WITH(g.weights_view("a", "d"),
+		                  "Cannot call gdwg::graph<N, E>::weights_view if src or dst node don't "
+		                  "exist in the graph");
+	}
+}
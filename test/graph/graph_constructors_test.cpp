@@ -2,6 +2,12 @@
 
 #include <catch2/catch.hpp>
 
+#include <iterator>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
 
 TEST_CASE("Default") {
 	auto g = gdwg::graph<int, std::string>{};
@@ -113,6 +119,16 @@ TEST_CASE("Copy Constructor") {
 		CHECK((*g_copy_it).to == "text");
 		CHECK((*g_copy_it).weight == 8);
 	}
+	SECTION("Copy outlives the original") {
+		auto g = std::make_unique<gdwg::graph<std::string, int>>(
+		   std::initializer_list<std::string>{"a", "b"});
+		g->insert_edge("a", "b", 4);
+		auto const g_copy = *g;
+		g.reset();
+
+		CHECK(g_copy.connections("a") == std::vector<std::string>{"b"});
+		CHECK(g_copy.incoming("b") == std::vector<std::string>{"a"});
+	}
 }
 
 TEST_CASE("Copy Assignment") {
@@ -229,4 +245,105 @@ TEST_CASE("Move Assignment") {
 		CHECK((*moved_from_it).weight == 5);
 	}
 
-}
\ No newline at end of file
+}
+
+TEST_CASE("Copies share until written") {
+	auto g = gdwg::graph<std::string, int>{"a", "b", "c"};
+	g.insert_edge("a", "b", 1);
+	g.insert_edge("b", "c", 2);
+
+	SECTION("Writes to either side aren't seen by the other") {
+		auto copy = g;
+		CHECK(copy == g);
+		copy.insert_edge("c", "a", 3);
+		g.erase_node("b");
+		CHECK(copy.connections("c") == std::vector<std::string>{"a"});
+		CHECK(copy.is_connected("a", "b"));
+		CHECK(g.nodes() == std::vector<std::string>{"a", "c"});
+		CHECK(g.begin() == g.end());
+	}
+
+	SECTION("Ids survive the first write") {
+		auto const copy = g;
+		auto const id = *g.id_of("c");
+		g.insert_node("d");
+		CHECK(g.node(id) == "c");
+		CHECK(copy.node(id) == "c");
+	}
+
+	SECTION("Iterators taken before the copy can still be erased") {
+		auto const it = g.find("b", "c", 2);
+		auto const copy = g;
+		auto const next = g.erase_edge(it);
+		CHECK(next == g.end());
+		CHECK(g.find("b", "c", 2) == g.end());
+		CHECK(copy.find("b", "c", 2) != copy.end());
+
+		auto const g2 = g;
+		auto const last = g.erase_edge(g.begin(), g.end());
+		CHECK(last == g.end());
+		CHECK(g.begin() == g.end());
+		CHECK(g2.is_connected("a", "b"));
+	}
+
+	SECTION("Calls that change nothing don't copy") {
+		auto const copy = g;
+		auto const shares = [&g, &copy] { return &(*g.begin()).weight == &(*copy.begin()).weight; };
+		auto const shares_nodes = [&g, &copy] {
+			return &*g.nodes_view().begin() == &*copy.nodes_view().begin();
+		};
+		auto const nodes = std::vector<std::string>{"a", "c"};
+		auto const edges = std::vector<gdwg::graph<std::string, int>::value_type>{{"a", "b", 1}};
+		auto const missing = std::vector<gdwg::graph<std::string, int>::value_type>{{"a", "b", 5}};
+		CHECK(shares());
+		CHECK(shares_nodes());
+		CHECK(!g.insert_node("a"));
+		CHECK(g.insert_nodes(nodes.begin(), nodes.end()) == 0);
+		CHECK(!g.insert_edge("a", "b", 1));
+		CHECK(!g.insert_edge(*g.id_of("b"), *g.id_of("c"), 2));
+		CHECK(g.insert_edges(edges.begin(), edges.end()) == 0);
+		CHECK(g.erase_edges(missing.begin(), missing.end()) == 0);
+		CHECK(shares());
+		CHECK(shares_nodes());
+		// Only the nodes are written, so the edges stay shared.
+		CHECK(g.insert_node("d"));
+		CHECK(!shares_nodes());
+		CHECK(shares());
+	}
+
+	SECTION("A write copies only the edges near it") {
+		auto big = gdwg::graph<int, int>{};
+		for (auto i = 0; i < 1000; ++i) {
+			big.insert_node(i);
+		}
+		for (auto i = 0; i < 999; ++i) {
+			big.insert_edge(i, i + 1, i);
+		}
+		auto const copy = big;
+		big.insert_edge(0, 0, -1);
+		CHECK(&(*big.find(0, 1, 0)).weight != &(*copy.find(0, 1, 0)).weight);
+		CHECK(&(*big.find(998, 999, 998)).weight == &(*copy.find(998, 999, 998)).weight);
+		CHECK(&*std::prev(big.nodes_view().end()) == &*std::prev(copy.nodes_view().end()));
+		CHECK(copy.find(0, 0, -1) == copy.end());
+	}
+
+	SECTION("Readers on other threads keep their snapshot") {
+		auto readers = std::vector<std::thread>{};
+		auto seen = std::vector<std::size_t>(4);
+		for (auto i = std::size_t{0}; i < seen.size(); ++i) {
+			readers.emplace_back([snapshot = g, &count = seen[i]] {
+				for (auto n = 0; n < 1000; ++n) {
+					count = static_cast<std::size_t>(std::distance(snapshot.begin(), snapshot.end()));
+				}
+			});
+		}
+		for (auto n = 0; n < 1000; ++n) {
+			g.insert_edge("c", "c", n);
+		}
+		for (auto& t : readers) {
+			t.join();
+		}
+		CHECK(seen == std::vector<std::size_t>(4, 2));
+		CHECK(std::distance(g.begin(), g.end()) == 1002);
+	}
+}
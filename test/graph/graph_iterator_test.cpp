@@ -1,5 +1,7 @@
 #include "gdwg/graph.hpp"
 #include <catch2/catch.hpp>
+#include <iterator>
+#include <string>
 #include <vector>
 
 
@@ -8,6 +10,7 @@ TEST_CASE("Empty") {
 	auto const g_empty = gdwg::graph<std::string, int>{};
 	CHECK(g_empty.begin() == g_empty.end());
 }
+
 TEST_CASE("Iterator "){
 	auto g = gdwg::graph<std::string, int>{"a", "b", "c"};
 	g.insert_edge("a", "b", 100);
@@ -62,5 +65,23 @@ TEST_CASE("Iterator "){
 		CHECK(g.begin() == g.begin());
 		CHECK(g2.begin() == g2.end());
 	}
+
+	SECTION("Dereference refers into the graph"){
+		auto const [from, to, weight] = *g_const.begin();
+		CHECK(&from == &(*g_const.begin()).from);
+		CHECK(&to == &from);
+		CHECK(weight == 50);
+
+		gdwg::graph<std::string, int>::value_type const copy = *std::next(g_const.begin());
+		CHECK(copy.from == "a");
+		CHECK(copy.to == "b");
+		CHECK(copy.weight == 100);
+
+		auto seen = std::vector<std::string>{};
+		for (auto const& [src, dst, w] : g_const) {
+			seen.push_back(src + dst + std::to_string(w));
+		}
+		CHECK(seen == std::vector<std::string>{"aa50", "ab100", "cb200"});
+	}
 }
 
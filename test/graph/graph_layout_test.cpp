@@ -0,0 +1,419 @@
+#include "gdwg/graph.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <cstdlib>
+#include <iterator>
+#include <new>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+// Every allocation in this program goes through these, so a test can count what a graph asks the
+// heap for.
+namespace {
+	auto allocations = std::size_t{0};
+} // namespace
+
+auto operator new(std::size_t size) -> void* {
+	++allocations;
+	if (auto* p = std::malloc(size == 0 ? 1 : size)) {
+		return p;
+	}
+	throw std::bad_alloc{};
+}
+
+auto operator delete(void* p) noexcept -> void {
+	std::free(p);
+}
+
+auto operator delete(void* p, std::size_t) noexcept -> void {
+	std::free(p);
+}
+
+auto operator new(std::size_t size, std::align_val_t align) -> void* {
+	++allocations;
+	auto const a = static_cast<std::size_t>(align);
+	if (auto* p = std::aligned_alloc(a, (size + a - 1) / a * a)) {
+		return p;
+	}
+	throw std::bad_alloc{};
+}
+
+auto operator delete(void* p, std::align_val_t) noexcept -> void {
+	std::free(p);
+}
+
+auto operator delete(void* p, std::size_t, std::align_val_t) noexcept -> void {
+	std::free(p);
+}
+
+auto operator new(std::size_t size, std::nothrow_t const&) noexcept -> void* {
+	try {
+		return ::operator new(size);
+	} catch (std::bad_alloc const&) {
+		return nullptr;
+	}
+}
+
+auto operator delete(void* p, std::nothrow_t const&) noexcept -> void {
+	std::free(p);
+}
+
+auto operator new(std::size_t size, std::align_val_t align, std::nothrow_t const&) noexcept
+   -> void* {
+	try {
+		return ::operator new(size, align);
+	} catch (std::bad_alloc const&) {
+		return nullptr;
+	}
+}
+
+auto operator delete(void* p, std::align_val_t, std::nothrow_t const&) noexcept -> void {
+	std::free(p);
+}
+
+namespace {
+	template<typename G>
+	auto edges_of(G const& g) -> std::vector<std::tuple<int, int, int>> {
+		auto v = std::vector<std::tuple<int, int, int>>{};
+		for (auto const& [from, to, weight] : g) {
+			v.emplace_back(from, to, weight);
+		}
+		return v;
+	}
+
+	template<typename G>
+	auto printed(G const& g) -> std::string {
+		auto out = std::ostringstream{};
+		out << g;
+		return out.str();
+	}
+
+	// A weight that counts its live copies and can be made to throw from a comparison.
+	struct fragile {
+		int value;
+
+		// The number of comparisons that succeed before the next one throws, or -1 if none
+		// will. Only that one throws, so that a rollback can still compare.
+		static inline auto compares_left = -1;
+		static inline auto live = 0;
+
+		explicit fragile(int v)
+		: value{v} {
+			++live;
+		}
+
+		fragile(fragile const& other)
+		: value{other.value} {
+			++live;
+		}
+
+		auto operator=(fragile const&) -> fragile& = default;
+
+		~fragile() {
+			--live;
+		}
+
+		friend auto operator==(fragile const& x, fragile const& y) -> bool {
+			return x.value == y.value;
+		}
+
+		friend auto operator<(fragile const& x, fragile const& y) -> bool {
+			if (compares_left >= 0 and compares_left-- == 0) {
+				throw std::runtime_error("comparison failed");
+			}
+			return x.value < y.value;
+		}
+	};
+} // namespace
+
+TEMPLATE_TEST_CASE("Graph layouts",
+                   "",
+                   gdwg::layout::edge_tree,
+                   gdwg::layout::adjacency,
+                   gdwg::layout::interned<>,
+                   gdwg::layout::interned<gdwg::layout::adjacency>) {
+	auto g = gdwg::graph<std::string, int, TestType>{"c", "a", "b", "d"};
+	g.insert_edge("b", "a", 4);
+	g.insert_edge("a", "c", 2);
+	g.insert_edge("a", "b", 3);
+	g.insert_edge("a", "b", 1);
+	g.insert_edge("c", "a", 5);
+
+	SECTION("edges come in (src, dst, weight) order both ways") {
+		using edge_t = std::tuple<std::string, std::string, int>;
+		auto const expected = std::vector<edge_t>{
+		   {"a", "b", 1}, {"a", "b", 3}, {"a", "c", 2}, {"b", "a", 4}, {"c", "a", 5}};
+		auto forward = std::vector<edge_t>{};
+		for (auto const& [from, to, weight] : g) {
+			forward.emplace_back(from, to, weight);
+		}
+		CHECK(forward == expected);
+		auto backward = std::vector<edge_t>{};
+		for (auto it = g.end(); it != g.begin();) {
+			auto const [from, to, weight] = *--it;
+			backward.emplace_back(from, to, weight);
+		}
+		CHECK(backward == std::vector<edge_t>(expected.rbegin(), expected.rend()));
+	}
+
+	SECTION("lookups") {
+		CHECK(g.connections("a") == std::vector<std::string>{"b", "b", "c"});
+		CHECK(g.incoming("a") == std::vector<std::string>{"b", "c"});
+		CHECK(g.weights("a", "b") == std::vector<int>{1, 3});
+		CHECK(g.is_connected("c", "a"));
+		CHECK(!g.is_connected("a", "d"));
+		CHECK(g.find("a", "b", 3) != g.end());
+		CHECK(g.find("a", "b", 2) == g.end());
+		CHECK(g.find("a", "z", 2) == g.end());
+	}
+
+	SECTION("erasing through iterators returns the next edge") {
+		auto it = g.erase_edge(g.find("a", "c", 2));
+		CHECK(it == g.find("b", "a", 4));
+		it = g.erase_edge(g.find("a", "b", 1), g.find("b", "a", 4));
+		CHECK(it == g.find("b", "a", 4));
+		CHECK(g.erase_edge(std::prev(g.end())) == g.end());
+		CHECK(printed(g) == "a (\n)\nb (\n  a | 4\n)\nc (\n)\nd (\n)\n");
+	}
+
+	SECTION("a node with many edges, erased in ranges") {
+		for (auto w = 10; w < 20; ++w) {
+			g.insert_edge("d", "a", w);
+			g.insert_edge("b", "d", w);
+		}
+		CHECK(g.weights("d", "a").size() == 10);
+		CHECK(g.incoming("d").size() == 10);
+		auto it = g.erase_edge(g.find("d", "a", 12), g.find("d", "a", 18));
+		CHECK(it == g.find("d", "a", 18));
+		CHECK(g.weights("d", "a") == std::vector<int>{10, 11, 18, 19});
+		it = g.erase_edge(g.find("b", "a", 4), g.find("d", "a", 11));
+		CHECK(it == g.find("d", "a", 11));
+		CHECK(printed(g)
+		      == "a (\n  b | 1\n  b | 3\n  c | 2\n)\nb (\n)\nc (\n)\n"
+		         "d (\n  a | 11\n  a | 18\n  a | 19\n)\n");
+		CHECK(g.incoming("d").empty());
+		CHECK(g.erase_edge(g.begin(), g.end()) == g.end());
+		CHECK(g.begin() == g.end());
+	}
+
+	SECTION("copies are independent") {
+		auto const copy = g;
+		g.merge_replace_node("c", "b");
+		CHECK(copy.is_node("c"));
+		CHECK(copy.weights("c", "a") == std::vector<int>{5});
+		CHECK(g.connections("b") == std::vector<std::string>{"a", "a"});
+		CHECK(!(g == copy));
+	}
+
+	SECTION("freezing and saving see the same graph") {
+		auto const frozen = g.freeze();
+		CHECK(frozen.num_edges() == 5);
+		CHECK(frozen.connections("a") == std::vector<std::string>{"b", "b", "c"});
+		auto buffer = std::stringstream{};
+		g.save(buffer);
+		auto loaded = gdwg::graph<std::string, int, TestType>{};
+		loaded.load(buffer);
+		CHECK(loaded == g);
+	}
+}
+
+TEMPLATE_TEST_CASE("Graph layouts agree with edge_tree",
+                   "",
+                   gdwg::layout::adjacency,
+                   gdwg::layout::interned<>,
+                   gdwg::layout::interned<gdwg::layout::adjacency>) {
+	auto tree = gdwg::graph<int, int, gdwg::layout::edge_tree>{};
+	auto adjacency = gdwg::graph<int, int, TestType>{};
+	auto rng = std::mt19937{6771};
+	auto value = std::uniform_int_distribution<int>{0, 24};
+	auto weight = std::uniform_int_distribution<int>{0, 3};
+	auto op = std::uniform_int_distribution<int>{0, 9};
+	for (auto step = 0; step < 4000; ++step) {
+		auto const src = value(rng);
+		auto const dst = value(rng);
+		auto const w = weight(rng);
+		switch (op(rng)) {
+		case 0:
+		case 1: CHECK(tree.insert_node(src) == adjacency.insert_node(src)); break;
+		case 2: CHECK(tree.erase_node(src) == adjacency.erase_node(src)); break;
+		case 3:
+			if (tree.is_node(src) and tree.is_node(dst)) {
+				CHECK(tree.replace_node(src, dst) == adjacency.replace_node(src, dst));
+			}
+			break;
+		case 4:
+			if (tree.is_node(src) and tree.is_node(dst)) {
+				tree.merge_replace_node(src, dst);
+				adjacency.merge_replace_node(src, dst);
+			}
+			break;
+		case 5:
+			if (tree.is_node(src) and tree.is_node(dst)) {
+				CHECK(tree.erase_edge(src, dst, w) == adjacency.erase_edge(src, dst, w));
+			}
+			break;
+		default:
+			if (tree.is_node(src) and tree.is_node(dst)) {
+				CHECK(tree.insert_edge(src, dst, w) == adjacency.insert_edge(src, dst, w));
+				CHECK(tree.incoming(dst) == adjacency.incoming(dst));
+			}
+			break;
+		}
+		if (tree.is_node(src)) {
+			REQUIRE(tree.connections(src) == adjacency.connections(src));
+			REQUIRE(tree.incoming(src) == adjacency.incoming(src));
+		}
+	}
+	CHECK(tree.nodes() == adjacency.nodes());
+	CHECK(edges_of(tree) == edges_of(adjacency));
+	CHECK(printed(tree) == printed(adjacency));
+	CHECK(tree.fingerprint() == adjacency.fingerprint());
+
+	auto tree_batch = std::vector<decltype(tree)::value_type>{};
+	auto adjacency_batch = std::vector<typename decltype(adjacency)::value_type>{};
+	auto const edges = edges_of(tree);
+	for (auto i = std::size_t{0}; i < edges.size(); i += 2) {
+		auto const [from, to, w] = edges[i];
+		tree_batch.push_back({from, to, w});
+		adjacency_batch.push_back({from, to, w});
+	}
+	CHECK(tree.erase_edges(tree_batch.begin(), tree_batch.end())
+	      == adjacency.erase_edges(adjacency_batch.begin(), adjacency_batch.end()));
+	CHECK(edges_of(tree) == edges_of(adjacency));
+}
+
+TEST_CASE("Interned weights") {
+	using graph = gdwg::graph<std::string, std::string, gdwg::layout::interned<>>;
+	auto g = graph{"a", "b", "c"};
+	g.insert_edge("a", "b", "knows");
+	g.insert_edge("b", "c", "knows");
+	g.insert_edge("a", "c", "likes");
+	g.insert_edge("a", "b", "blocks");
+
+	SECTION("weights order by value, not by when they were first seen") {
+		CHECK(g.weights("a", "b") == std::vector<std::string>{"blocks", "knows"});
+		CHECK(printed(g)
+		      == "a (\n  b | blocks\n  b | knows\n  c | likes\n)\nb (\n  c | knows\n)\nc (\n)\n");
+	}
+
+	SECTION("a weight no edge has finds nothing") {
+		CHECK(g.find("a", "b", "hates") == g.end());
+		CHECK(!g.erase_edge("a", "b", "hates"));
+		CHECK(g.erase_edge("a", "c", "likes"));
+		CHECK(g.find("a", "c", "likes") == g.end());
+		CHECK(g.insert_edge("c", "a", "likes"));
+		CHECK(g.weights("c", "a") == std::vector<std::string>{"likes"});
+	}
+
+	SECTION("a shared weight outlives any one of its edges") {
+		auto const copy = g;
+		CHECK(g.erase_node("b"));
+		CHECK(g.connections("a") == std::vector<std::string>{"c"});
+		CHECK(copy.weights("b", "c") == std::vector<std::string>{"knows"});
+		g.clear();
+		CHECK(g.insert_node("a"));
+		CHECK(g.insert_edge("a", "a", "knows"));
+		CHECK(g.weights("a", "a") == std::vector<std::string>{"knows"});
+	}
+
+	SECTION("the same graph as without interning") {
+		auto plain = gdwg::graph<std::string, std::string>{"a", "b", "c"};
+		plain.insert_edge("a", "b", "knows");
+		plain.insert_edge("b", "c", "knows");
+		plain.insert_edge("a", "c", "likes");
+		plain.insert_edge("a", "b", "blocks");
+		CHECK(printed(plain) == printed(g));
+		CHECK(plain.fingerprint() == g.fingerprint());
+		auto buffer = std::stringstream{};
+		plain.save(buffer);
+		auto loaded = graph{};
+		loaded.load(buffer);
+		CHECK(loaded == g);
+		g.replace_node("a", "z");
+		g.merge_replace_node("b", "c");
+		CHECK(printed(g) == "c (\n  c | knows\n)\nz (\n  c | blocks\n  c | knows\n  c | likes\n)\n");
+	}
+}
+
+TEMPLATE_TEST_CASE("Insertions that throw don't keep an interned weight",
+                   "",
+                   gdwg::layout::interned<>,
+                   gdwg::layout::interned<gdwg::layout::adjacency>) {
+	using graph = gdwg::graph<int, fragile, TestType>;
+	auto g = graph{1, 2};
+	g.insert_edge(1, 2, fragile{1});
+	auto const weight = fragile{2};
+
+	// Lets one more comparison through each time until insert succeeds, checking that every
+	// failure left only the weights the edges hold.
+	auto const check_rollback = [&g](auto const& insert) {
+		auto const live = fragile::live;
+		for (auto n = 0;; ++n) {
+			fragile::compares_left = n;
+			try {
+				insert();
+				break;
+			} catch (std::runtime_error const&) {
+				CHECK(fragile::live == live);
+				CHECK(g.weights(1, 2) == std::vector<fragile>{fragile{1}});
+			}
+		}
+		fragile::compares_left = -1;
+		CHECK(fragile::live == live + 1);
+		CHECK(g.weights(1, 2) == std::vector<fragile>{fragile{1}, fragile{2}});
+	};
+
+	SECTION("insert_edge") {
+		check_rollback([&g, &weight] { g.insert_edge(1, 2, weight); });
+	}
+
+	SECTION("insert_edges") {
+		auto const batch = std::vector<typename graph::value_type>{{1, 2, weight}};
+		check_rollback([&g, &batch] { g.insert_edges(batch.begin(), batch.end()); });
+	}
+}
+
+TEST_CASE("Adjacency keeps a node's first few edges in its entry") {
+	constexpr auto n = 1000;
+	auto g = gdwg::graph<int, int, gdwg::layout::adjacency>{};
+	for (auto i = 0; i < n; ++i) {
+		g.insert_node(i);
+	}
+	// The first edge each way makes every node's entry.
+	for (auto i = 0; i < n; ++i) {
+		g.insert_edge(i, (i + 1) % n, i);
+	}
+
+	SECTION("a second edge each way allocates nothing") {
+		auto const before = allocations;
+		for (auto i = 0; i < n; ++i) {
+			g.insert_edge(i, (i + 2) % n, i);
+		}
+		CHECK(allocations == before);
+		CHECK(g.connections(7) == std::vector<int>{8, 9});
+	}
+
+	SECTION("a node with many edges moves them into a tree and back") {
+		for (auto i = 0; i < n; ++i) {
+			g.insert_edge(0, i, -i);
+		}
+		CHECK(g.weights(0, 1) == std::vector<int>{-1, 0});
+		for (auto i = 0; i < n; ++i) {
+			g.erase_edge(0, i, -i);
+		}
+		CHECK(g.weights(0, 1) == std::vector<int>{0});
+		g.erase_edge(0, 1, 0);
+		CHECK(g.connections(0).empty());
+		auto const before = allocations;
+		g.insert_edge(0, 2, 0);
+		g.insert_edge(0, 3, 0);
+		CHECK(allocations == before);
+		CHECK(g.connections(0) == std::vector<int>{2, 3});
+	}
+}
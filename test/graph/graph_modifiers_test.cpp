@@ -34,6 +34,60 @@ TEST_CASE("Insert edge") {
 	CHECK_THROWS(g1.insert_edge(4, 5, 7));
 }
 
+TEST_CASE("Insert nodes (range)") {
+	auto g = gdwg::graph<std::string, int>{"b", "d"};
+	auto const batch = std::vector<std::string>{"e", "a", "d", "c", "a", "f"};
+	CHECK(g.insert_nodes(batch.begin(), batch.end()) == 4);
+	CHECK(g.nodes() == std::vector<std::string>{"a", "b", "c", "d", "e", "f"});
+	CHECK(g.insert_nodes(batch.begin(), batch.end()) == 0);
+	CHECK(g.insert_nodes(batch.end(), batch.end()) == 0);
+}
+
+TEST_CASE("Insert edges (range)") {
+	using graph = gdwg::graph<int, int>;
+	auto g = graph{1, 2, 3};
+	g.insert_edge(2, 3, 100);
+
+	SECTION("new, existing and repeated edges") {
+		auto const batch = std::vector<graph::value_type>{
+		   {3, 1, 10},
+		   {1, 2, 60},
+		   {2, 3, 100},
+		   {1, 2, 50},
+		   {3, 1, 10},
+		   {1, 1, 5},
+		};
+		CHECK(g.insert_edges(batch.begin(), batch.end()) == 4);
+		CHECK(g.connections(1) == std::vector<int>{1, 2, 2});
+		CHECK(g.weights(1, 2) == std::vector<int>{50, 60});
+		CHECK(g.incoming(1) == std::vector<int>{1, 3});
+		CHECK(g.incoming(3) == std::vector<int>{2});
+		CHECK(g.insert_edges(batch.begin(), batch.end()) == 0);
+	}
+
+	SECTION("nothing is inserted if an endpoint is missing") {
+		auto const batch = std::vector<graph::value_type>{{1, 2, 50}, {99, 2, 50}};
+		CHECK_THROWS(g.insert_edges(batch.begin(), batch.end()));
+		CHECK(g.find(1, 2, 50) == g.end());
+	}
+
+	SECTION("matches inserting one at a time") {
+		auto batch = std::vector<graph::value_type>{};
+		auto one_by_one = graph{1, 2, 3};
+		one_by_one.insert_edge(2, 3, 100);
+		for (auto i = 0; i < 50; ++i) {
+			auto const e = graph::value_type{i % 3 + 1, (i * 7) % 3 + 1, i % 11};
+			batch.push_back(e);
+			one_by_one.insert_edge(e.from, e.to, e.weight);
+		}
+		g.insert_edges(batch.begin(), batch.end());
+		CHECK(g == one_by_one);
+		for (auto n = 1; n <= 3; ++n) {
+			CHECK(g.incoming(n) == one_by_one.incoming(n));
+		}
+	}
+}
+
 TEST_CASE("Clear"){
 	      // nodes
 	      SECTION("Clear nodes") {
@@ -49,6 +103,17 @@ TEST_CASE("Clear"){
 		      g.clear();
 		      CHECK(g.empty());
 	      }
+	      // the graph is usable again after its storage was released
+	      SECTION("Reuse after clear") {
+		      auto g = gdwg::graph<std::string, int>{"a", "b"};
+		      g.insert_edge("a", "b", 1);
+		      g.clear();
+		      CHECK(g.insert_node("c"));
+		      CHECK(g.insert_node("a"));
+		      CHECK(g.insert_edge("c", "a", 2));
+		      CHECK(g.nodes() == std::vector<std::string>{"a", "c"});
+		      CHECK(g.connections("c") == std::vector<std::string>{"a"});
+	      }
 }
 //
 //	// Non-relevant is not removed
@@ -92,6 +157,44 @@ TEST_CASE("Erase node") {
 
 }
 
+TEST_CASE("Node mutations keep incoming edges in step") {
+	auto g = gdwg::graph<int, int>{1, 2, 3};
+	g.insert_edge(1, 2, 50);
+	g.insert_edge(2, 2, 60);
+	g.insert_edge(3, 2, 70);
+	g.insert_edge(2, 3, 80);
+
+	SECTION("erase node") {
+		CHECK(g.erase_node(2));
+		CHECK(g.incoming(3).empty());
+		CHECK(g.connections(1).empty());
+		CHECK(g.connections(3).empty());
+	}
+
+	SECTION("replace node") {
+		CHECK(g.replace_node(2, 9));
+		CHECK(g.incoming(9) == std::vector<int>{1, 3, 9});
+		CHECK(g.incoming(3) == std::vector<int>{9});
+	}
+
+	SECTION("merge replace node") {
+		g.insert_edge(1, 3, 80);
+		g.merge_replace_node(2, 1);
+		CHECK(g.incoming(1) == std::vector<int>{1, 1, 3});
+		CHECK(g.incoming(3) == std::vector<int>{1});
+		CHECK(g.weights(1, 3) == std::vector<int>{80});
+	}
+
+	SECTION("erase edge") {
+		CHECK(g.erase_edge(3, 2, 70));
+		g.erase_edge(g.find(1, 2, 50));
+		CHECK(g.incoming(2) == std::vector<int>{2});
+		g.erase_edge(g.begin(), g.end());
+		CHECK(g.incoming(2).empty());
+		CHECK(g.incoming(3).empty());
+	}
+}
+
 
 TEST_CASE("Erase edge (src, dst, weight)") {
 	auto g = gdwg::graph<int, int>{1, 2, 3};
@@ -114,6 +217,47 @@ TEST_CASE("Erase edge (src, dst, weight)") {
 	CHECK_THROWS(g.erase_edge(7, 8, 50));
 }
 
+TEST_CASE("Erased edges can be inserted again") {
+	auto g = gdwg::graph<std::string, std::string>{"a", "b"};
+	for (auto round = 0; round < 3; ++round) {
+		CHECK(g.insert_edge("a", "b", "x"));
+		CHECK(g.insert_edge("b", "a", "y"));
+		CHECK(!g.insert_edge("a", "b", "x"));
+		CHECK(g.erase_edge("a", "b", "x"));
+		CHECK(g.erase_edge(g.begin()) == g.end());
+	}
+	CHECK(g.begin() == g.end());
+	CHECK(g.nodes() == std::vector<std::string>{"a", "b"});
+}
+
+TEST_CASE("Erase edges (range)") {
+	using graph = gdwg::graph<int, int>;
+	auto g = graph{1, 2, 3};
+	g.insert_edge(1, 2, 50);
+	g.insert_edge(1, 2, 60);
+	g.insert_edge(2, 3, 100);
+	g.insert_edge(3, 1, 10);
+
+	SECTION("erase existing, missing and repeated edges") {
+		auto const batch = std::vector<graph::value_type>{
+		   {3, 1, 10},
+		   {1, 2, 60},
+		   {1, 2, 70},
+		   {1, 2, 50},
+		   {3, 1, 10},
+		};
+		CHECK(g.erase_edges(batch.begin(), batch.end()) == 3);
+		CHECK(g.find(2, 3, 100) != g.end());
+		CHECK(g.connections(1).empty());
+		CHECK(g.incoming(1).empty());
+	}
+
+	SECTION("nothing is erased if an endpoint is missing") {
+		auto const batch = std::vector<graph::value_type>{{1, 2, 50}, {1, 99, 50}};
+		CHECK_THROWS(g.erase_edges(batch.begin(), batch.end()));
+		CHECK(g.find(1, 2, 50) != g.end());
+	}
+}
 
 TEST_CASE("Erase edge: (iterator i)") {
 	auto g = gdwg::graph<int, int>{1, 2, 3};
@@ -137,6 +281,7 @@ TEST_CASE("Erase edge: (iterator i)") {
 	CHECK(g.find(3, 2, 4) != g.end());
 	
 }
+
 TEST_CASE("Erase edge: (iterator i, iterator s)") {
 	auto g = gdwg::graph<int, int>{1, 2, 3};
 	
@@ -236,6 +381,18 @@ TEST_CASE("Merge replace node") {
 		CHECK(g2.weights(2, 2) == std::vector<int>{7});
 	}
 
+	SECTION("Into itself") {
+		auto g3 = gdwg::graph<int, int>{1, 2};
+		g3.insert_edge(1, 1, 7);
+		g3.insert_edge(1, 2, 8);
+
+		g3.merge_replace_node(1, 1);
+
+		CHECK(g3.is_node(1));
+		CHECK(g3.weights(1, 1) == std::vector<int>{7});
+		CHECK(g3.connections(1) == std::vector<int>{1, 2});
+	}
+
 }
 
 
@@ -3,6 +3,7 @@
 #include <catch2/catch.hpp>
 
 #include <vector>
+#include <iomanip>
 #include <iostream>
 #include <iterator>
 #include <set>
@@ -86,4 +87,115 @@ TEST_CASE("Extractor ") {
 )");
 	CHECK(out.str() == expected_output);
 
-}
\ No newline at end of file
+}
+
+TEST_CASE("Fingerprint") {
+	auto g = gdwg::graph<std::string, int>{"a", "b", "c"};
+	g.insert_edge("a", "b", 1);
+	g.insert_edge("b", "c", 2);
+
+	SECTION("Doesn't depend on insertion order") {
+		auto h = gdwg::graph<std::string, int>{"c", "b", "a"};
+		h.insert_edge("b", "c", 2);
+		h.insert_edge("a", "b", 1);
+		CHECK(h.fingerprint() == g.fingerprint());
+		CHECK(h == g);
+	}
+
+	SECTION("Changes with the contents and comes back with them") {
+		auto const before = g.fingerprint();
+		g.insert_edge("b", "a", 1);
+		CHECK(g.fingerprint() != before);
+		g.erase_edge("b", "a", 1);
+		CHECK(g.fingerprint() == before);
+
+		auto const copy = g;
+		g.replace_node("a", "d");
+		CHECK(g.fingerprint() != before);
+		CHECK(g != copy);
+		g.replace_node("d", "a");
+		CHECK(g.fingerprint() == before);
+	}
+
+	SECTION("Matches a graph built directly") {
+		g.merge_replace_node("a", "c");
+		auto const values = std::vector<gdwg::graph<std::string, int>::value_type>{{"c", "b", 1},
+		                                                                           {"b", "c", 2}};
+		auto h = gdwg::graph<std::string, int>{"b", "c"};
+		h.insert_edges(values.begin(), values.end());
+		CHECK(h.fingerprint() == g.fingerprint());
+		CHECK(h == g);
+	}
+
+	SECTION("Empty graphs") {
+		auto const empty = gdwg::graph<std::string, int>{};
+		CHECK(empty.fingerprint() == 0);
+		g.clear();
+		CHECK(g.fingerprint() == empty.fingerprint());
+	}
+}
+
+TEST_CASE("Extractor formats like the stream") {
+	using graph = gdwg::graph<int, double>;
+	auto g = graph{};
+	auto const weights = std::vector<double>{0.1, -2.5, 1e-7, 123456789.0, 3.0, 1.0 / 3.0};
+	for (auto n = 0; n < 4000; ++n) {
+		g.insert_node(n * 1000 - 7);
+	}
+	for (auto n = 0; n < 4000; ++n) {
+		auto const weight = weights[static_cast<std::size_t>(n) % weights.size()];
+		g.insert_edge(n * 1000 - 7, (n * 7 % 4000) * 1000 - 7, weight);
+	}
+
+	// What printing one insertion at a time gives.
+	auto const expected = [&g](auto const& set_up) {
+		auto out = std::ostringstream{};
+		set_up(out);
+		auto it = g.begin();
+		for (auto const& node : g.nodes()) {
+			out << node << " (\n";
+			for (; it != g.end() and (*it).from == node; ++it) {
+				out << "  " << (*it).to << " | " << (*it).weight << "\n";
+			}
+			out << ")\n";
+		}
+		return out.str();
+	};
+	auto const actual = [&g](auto const& set_up) {
+		auto out = std::ostringstream{};
+		set_up(out);
+		out << g;
+		return out.str();
+	};
+
+	auto const defaults = [](std::ostream&) {};
+	auto const precise = [](std::ostream& os) { os.precision(12); };
+	auto const fixed_hex = [](std::ostream& os) { os << std::fixed << std::hex << std::showpos; };
+	auto const wide = [](std::ostream& os) { os << std::setw(12); };
+	auto const wide_left = [](std::ostream& os) {
+		os << std::setw(12) << std::left << std::setfill('*');
+	};
+	CHECK(actual(defaults) == expected(defaults));
+	CHECK(actual(precise) == expected(precise));
+	CHECK(actual(fixed_hex) == expected(fixed_hex));
+	CHECK(actual(wide) == expected(wide));
+	CHECK(actual(wide_left) == expected(wide_left));
+	CHECK(actual(defaults).size() > (std::size_t{1} << 16));
+}
+
+TEST_CASE("Extractor pads only the first value to the stream's width") {
+	auto g = gdwg::graph<std::string, int>{"a", "b"};
+	g.insert_edge("a", "b", 1);
+	auto out = std::ostringstream{};
+	out << std::setw(5) << g << "x";
+	CHECK(out.str() == "    a (\n  b | 1\n)\nb (\n)\nx");
+
+	auto numbers = gdwg::graph<int, int>{1};
+	auto out_numbers = std::ostringstream{};
+	out_numbers << std::setw(5) << numbers << "x";
+	CHECK(out_numbers.str() == "    1 (\n)\nx");
+
+	auto out_empty = std::ostringstream{};
+	out_empty << std::setw(5) << gdwg::graph<int, int>{} << "x";
+	CHECK(out_empty.str() == "x");
+}
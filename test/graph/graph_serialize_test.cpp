@@ -0,0 +1,182 @@
+#include "gdwg/graph.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <iterator>
+#include <limits>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+	struct point {
+		int x;
+		int y;
+
+		auto operator==(point const&) const -> bool = default;
+		auto operator<=>(point const&) const = default;
+
+		friend auto operator<<(std::ostream& os, point const& p) -> std::ostream& {
+			return os << '(' << p.x << ", " << p.y << ')';
+		}
+	};
+} // namespace
+
+// Written as two ints, to check that the customisation point is used.
+template<>
+struct gdwg::serializer<point> {
+	static auto write(std::ostream& os, point const& p) -> void {
+		serializer<int>::write(os, p.x);
+		serializer<int>::write(os, p.y);
+	}
+
+	static auto read(std::istream& is) -> point {
+		auto const x = serializer<int>::read(is);
+		return point{x, serializer<int>::read(is)};
+	}
+};
+
+TEST_CASE("Save and load") {
+	auto g = gdwg::graph<std::string, double>{"a", "b", "c", "text"};
+	g.insert_edge("a", "b", 1.5);
+	g.insert_edge("a", "b", -2);
+	g.insert_edge("text", "a", 0.25);
+	g.insert_edge("c", "c", 7);
+
+	SECTION("Round trip") {
+		auto out = std::stringstream{};
+		g.save(out);
+		auto loaded = gdwg::graph<std::string, double>{"x"};
+		loaded.load(out);
+		CHECK(loaded == g);
+		CHECK(loaded.fingerprint() == g.fingerprint());
+		CHECK(loaded.incoming("a") == std::vector<std::string>{"text"});
+		CHECK(loaded.insert_edge("b", "a", 3));
+	}
+
+	SECTION("Empty graph") {
+		auto out = std::stringstream{};
+		gdwg::graph<std::string, double>{}.save(out);
+		g.load(out);
+		CHECK(g.empty());
+	}
+
+	SECTION("Custom types") {
+		auto p = gdwg::graph<point, point>{{0, 0}, {1, -1}};
+		p.insert_edge({1, -1}, {0, 0}, {3, 4});
+		auto out = std::stringstream{};
+		p.save(out);
+		auto loaded = gdwg::graph<point, point>{};
+		loaded.load(out);
+		CHECK(loaded == p);
+	}
+
+	SECTION("Bad input leaves the graph alone") {
+		auto const copy = g;
+		auto out = std::stringstream{};
+		g.save(out);
+		auto const bytes = out.str();
+		auto const message = "Cannot call gdwg::graph<N, E>::load on a stream that doesn't hold a "
+		                     "saved graph";
+
+		auto truncated = std::stringstream(bytes.substr(0, bytes.size() - 3));
+		CHECK_THROWS_WITH(g.load(truncated), message);
+		auto wrong_magic = std::stringstream("XDWG" + bytes.substr(4));
+		CHECK_THROWS_WITH(g.load(wrong_magic), message);
+		auto text = std::stringstream{};
+		text << g;
+		CHECK_THROWS_WITH(g.load(text), message);
+		CHECK(g == copy);
+	}
+}
+
+TEST_CASE("Load edge list") {
+	SECTION("whitespace, CSV, comments and missing weights") {
+		auto is = std::istringstream("# SNAP-style comment\n"
+		                             "% KONECT-style comment\n"
+		                             "1 2 0.5\n"
+		                             "\n"
+		                             "2\t3\t1.5\r\n"
+		                             "3,1,2.5\n"
+		                             "  10 1 4 1262304000\n"
+		                             "1 2 0.5\n"
+		                             "1 3\n"
+		                             "3 3 -1e2");
+		auto g = gdwg::graph<int, double>{};
+		g.load_edge_list(is, 7.0);
+		CHECK(g.nodes() == std::vector<int>{1, 2, 3, 10});
+		CHECK(g.weights(1, 2) == std::vector<double>{0.5});
+		CHECK(g.weights(2, 3) == std::vector<double>{1.5});
+		CHECK(g.weights(3, 1) == std::vector<double>{2.5});
+		CHECK(g.weights(10, 1) == std::vector<double>{4});
+		CHECK(g.weights(1, 3) == std::vector<double>{7.0});
+		CHECK(g.weights(3, 3) == std::vector<double>{-100});
+		CHECK(std::distance(g.begin(), g.end()) == 6);
+
+		auto expected = gdwg::graph<int, double>{1, 2, 3, 10};
+		for (auto it = g.begin(); it != g.end(); ++it) {
+			expected.insert_edge((*it).from, (*it).to, (*it).weight);
+		}
+		CHECK(g == expected);
+		CHECK(g.fingerprint() == expected.fingerprint());
+	}
+
+	SECTION("sparse and negative node values") {
+		auto is = std::istringstream("-5 4000000000 1\n4000000000 -5 2\n7 7 3\n");
+		auto g = gdwg::graph<long long, int>{};
+		g.load_edge_list(is);
+		CHECK(g.nodes() == std::vector<long long>{-5, 7, 4000000000});
+		CHECK(g.connections(-5) == std::vector<long long>{4000000000});
+		CHECK(g.weights(4000000000, -5) == std::vector<int>{2});
+		CHECK(g.is_connected(7, 7));
+	}
+
+	SECTION("lines longer than a read chunk") {
+		auto text = std::string{};
+		for (auto i = 0; i < 100000; ++i) {
+			text += std::to_string(i) + " " + std::to_string((i * 7) % 100000) + " 1\n";
+		}
+		text += std::string(3 << 20, ' ') + "5 6 2\n";
+		auto is = std::istringstream(text);
+		auto g = gdwg::graph<long, int>{};
+		g.load_edge_list(is);
+		CHECK(g.nodes().size() == 100000);
+		CHECK(g.is_connected(1, 7));
+		CHECK(g.weights(5, 6) == std::vector<int>{2});
+	}
+
+	SECTION("a line that isn't an edge throws and leaves the graph as it was") {
+		auto g = gdwg::graph<int, double>{1, 2};
+		g.insert_edge(1, 2, 3.0);
+		auto const before = g;
+		auto const malformed = std::vector<std::pair<char const*, char const*>>{
+		   {"1 2 3\n1 x 3\n", "2"},
+		   {"1\n", "1"},
+		   {"# comment\n\n1 2 3x\n", "3"},
+		   {"1 2 3.5.5\n", "1"},
+		};
+		for (auto const& [text, line] : malformed) {
+			auto is = std::istringstream(text);
+			CHECK_THROWS_WITH(g.load_edge_list(is),
+			                  std::string("Cannot call gdwg::graph<N, E>::load_edge_list on a stream "
+			                              "with a line that isn't an edge (line ")
+			                     + line + ")");
+			CHECK(g == before);
+		}
+	}
+
+	SECTION("NaN nodes and weights are malformed") {
+		auto g = gdwg::graph<double, double>{};
+		for (auto const* text : {"nan 1 1\n1 nan 2\n", "1 2 3\n1 2 -nan\n", "1 2 NAN\n"}) {
+			auto is = std::istringstream(text);
+			CHECK_THROWS(g.load_edge_list(is));
+			CHECK(g.empty());
+		}
+		auto is = std::istringstream("inf 1 1\n1 -inf 2\n");
+		g.load_edge_list(is);
+		CHECK(g.nodes().size() == 3);
+		CHECK(g.is_connected(1, -std::numeric_limits<double>::infinity()));
+	}
+}
@@ -0,0 +1,161 @@
+#include "gdwg/graph.hpp"
+#include "gdwg/mapped_graph.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+	// A file in the temporary directory, removed when it goes out of scope.
+	struct temp_file {
+		std::filesystem::path path;
+
+		explicit temp_file(std::string const& name)
+		: path{std::filesystem::temp_directory_path() / name} {}
+
+		temp_file(temp_file const&) = delete;
+		auto operator=(temp_file const&) -> temp_file& = delete;
+
+		~temp_file() {
+			std::filesystem::remove(path);
+		}
+	};
+
+	auto write_file(std::filesystem::path const& path, std::string const& bytes) -> void {
+		auto file = std::ofstream(path, std::ios_base::binary);
+		file << bytes;
+	}
+} // namespace
+
+TEST_CASE("Mapped graph") {
+	using mapped = gdwg::mapped_graph<int, double>;
+	auto g = gdwg::graph<int, double>{1, 2, 3, 4, 7};
+	g.insert_edge(1, 2, 3.5);
+	g.insert_edge(1, 2, 1.0);
+	g.insert_edge(1, 1, 2.0);
+	g.insert_edge(3, 1, 5.0);
+	g.insert_edge(3, 4, 4.0);
+
+	auto const file = temp_file("gdwg_mapped_graph_test.csr");
+	auto saved = std::ostringstream{};
+	mapped::write(g.freeze(), saved);
+	write_file(file.path, saved.str());
+	auto m = mapped(file.path);
+
+	SECTION("accessors match the graph") {
+		CHECK(m.nodes() == g.nodes());
+		CHECK(m.num_edges() == 5);
+		CHECK(m.is_node(7));
+		CHECK(!m.is_node(5));
+		CHECK(m.connections(1) == g.connections(1));
+		CHECK(m.connections(2).empty());
+		CHECK(m.weights(1, 2) == std::vector<double>{1.0, 3.5});
+		CHECK(m.is_connected(3, 4));
+		CHECK(!m.is_connected(4, 3));
+		CHECK_THROWS(m.connections(5));
+		CHECK_THROWS(m.is_connected(1, 5));
+		CHECK(m.find(3, 1, 5.0) != m.end());
+		CHECK(m.find(3, 1, 6.0) == m.end());
+	}
+
+	SECTION("iteration and printing match the graph") {
+		auto expected = std::vector<gdwg::graph<int, double>::value_type>{};
+		for (auto it = g.begin(); it != g.end(); ++it) {
+			expected.push_back(*it);
+		}
+		auto forward = std::vector<gdwg::graph<int, double>::value_type>{};
+		for (auto it = m.begin(); it != m.end(); ++it) {
+			forward.push_back({(*it).from, (*it).to, (*it).weight});
+		}
+		REQUIRE(forward.size() == expected.size());
+		for (auto i = std::size_t{0}; i < expected.size(); ++i) {
+			CHECK(forward[i].from == expected[i].from);
+			CHECK(forward[i].to == expected[i].to);
+			CHECK(forward[i].weight == expected[i].weight);
+		}
+		CHECK((*--m.end()).from == 3);
+
+		auto from_graph = std::ostringstream{};
+		from_graph << g;
+		auto from_mapping = std::ostringstream{};
+		from_mapping << m;
+		CHECK(from_mapping.str() == from_graph.str());
+	}
+
+	SECTION("moving keeps the mapping") {
+		auto const moved = mapped(std::move(m));
+		CHECK(moved.is_connected(1, 2));
+		CHECK(m.empty());
+	}
+
+	SECTION("an empty graph maps") {
+		auto const empty_file = temp_file("gdwg_mapped_graph_test_empty.csr");
+		auto empty = std::ostringstream{};
+		mapped::write(gdwg::graph<int, double>{}.freeze(), empty);
+		write_file(empty_file.path, empty.str());
+		auto const e = mapped(empty_file.path);
+		CHECK(e.empty());
+		CHECK(e.begin() == e.end());
+	}
+
+	SECTION("files that don't hold a mapped graph are rejected") {
+		auto const bad = temp_file("gdwg_mapped_graph_test_bad.csr");
+		CHECK_THROWS_WITH(mapped(bad.path),
+		                  "Cannot construct gdwg::mapped_graph<N, E> from a file that can't be "
+		                  "opened");
+
+		write_file(bad.path, saved.str().substr(0, saved.str().size() - 1));
+		CHECK_THROWS_WITH(mapped(bad.path),
+		                  "Cannot construct gdwg::mapped_graph<N, E> from a file that doesn't hold "
+		                  "a mapped graph");
+
+		auto wrong_magic = saved.str();
+		wrong_magic[0] = 'X';
+		write_file(bad.path, wrong_magic);
+		CHECK_THROWS(mapped(bad.path));
+
+		CHECK_THROWS(gdwg::mapped_graph<int, float>(file.path));
+	}
+
+	SECTION("verify() finds an edge to a node that doesn't exist") {
+		// The header's targets_at, after the magic, four u32 fields and two u64 counts.
+		auto corrupt = saved.str();
+		auto targets_at = std::uint64_t{0};
+		std::memcpy(&targets_at, corrupt.data() + 56, sizeof(targets_at));
+		auto const bad_target = std::uint32_t{5};
+		std::memcpy(corrupt.data() + targets_at + 4, &bad_target, sizeof(bad_target));
+		auto const bad = temp_file("gdwg_mapped_graph_test_target.csr");
+		write_file(bad.path, corrupt);
+		auto const m = mapped(bad.path);
+		CHECK_THROWS_WITH(m.verify(),
+		                  "Cannot call gdwg::mapped_graph<N, E>::verify on a file whose offsets or "
+		                  "targets are corrupt");
+
+		auto const last_target = std::uint32_t{4};
+		std::memcpy(corrupt.data() + targets_at + 4, &last_target, sizeof(last_target));
+		write_file(bad.path, corrupt);
+		auto const fixed = mapped(bad.path);
+		CHECK_NOTHROW(fixed.verify());
+		CHECK(fixed.connections(1) == std::vector<int>{1, 7, 2});
+	}
+
+	SECTION("verify() finds offsets out of order") {
+		// The header's offsets_at, just before targets_at.
+		auto corrupt = saved.str();
+		auto offsets_at = std::uint64_t{0};
+		std::memcpy(&offsets_at, corrupt.data() + 48, sizeof(offsets_at));
+		auto const bad_offset = std::uint64_t{1000};
+		std::memcpy(corrupt.data() + offsets_at + 8, &bad_offset, sizeof(bad_offset));
+		auto const bad = temp_file("gdwg_mapped_graph_test_offsets.csr");
+		write_file(bad.path, corrupt);
+		CHECK_THROWS(mapped(bad.path).verify());
+		CHECK_NOTHROW(mapped(file.path).verify());
+	}
+}
@@ -0,0 +1,109 @@
+#include "gdwg/graph.hpp"
+#include "gdwg/pagerank.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+	// The textbook power iteration, one node at a time, to check against.
+	template<typename N, typename E>
+	auto expected_ranks(gdwg::frozen_graph<N, E> const& g, double damping) -> std::vector<double> {
+		auto const n = static_cast<double>(g.num_nodes());
+		auto rank = std::vector<double>(g.num_nodes(), 1 / n);
+		for (auto iteration = 0; iteration < 200; ++iteration) {
+			// Nodes without out-edges spread their rank over every node.
+			auto dangling = 0.0;
+			for (auto u = std::size_t{0}; u < g.num_nodes(); ++u) {
+				if (g.out_degree(u) == 0) {
+					dangling += rank[u];
+				}
+			}
+			auto next = std::vector<double>(g.num_nodes(), (1 - damping + damping * dangling) / n);
+			for (auto u = std::size_t{0}; u < g.num_nodes(); ++u) {
+				for (auto const v : g.targets(u)) {
+					next[v] += damping * rank[u] / static_cast<double>(g.out_degree(u));
+				}
+			}
+			rank = next;
+		}
+		return rank;
+	}
+} // namespace
+
+TEST_CASE("PageRank") {
+	SECTION("a cycle ranks every node the same") {
+		auto g = gdwg::graph<std::string, int>{"a", "b", "c"};
+		g.insert_edge("a", "b", 1);
+		g.insert_edge("b", "c", 1);
+		g.insert_edge("c", "a", 1);
+		for (auto const r : gdwg::pagerank(g.freeze())) {
+			CHECK(r == Approx(1.0 / 3));
+		}
+	}
+
+	SECTION("links, parallel edges and a node without out-edges") {
+		auto g = gdwg::graph<std::string, int>{"a", "b", "c", "d"};
+		g.insert_edge("a", "b", 1);
+		g.insert_edge("a", "b", 2);
+		g.insert_edge("a", "c", 1);
+		g.insert_edge("b", "c", 1);
+		g.insert_edge("c", "a", 1);
+		auto const frozen = g.freeze();
+		auto const ranks = gdwg::pagerank(frozen, 0.85, 1e-12, 2);
+		auto const expected = expected_ranks(frozen, 0.85);
+		REQUIRE(ranks.size() == expected.size());
+		for (auto i = std::size_t{0}; i < ranks.size(); ++i) {
+			CHECK(ranks[i] == Approx(expected[i]));
+		}
+		CHECK(std::accumulate(ranks.begin(), ranks.end(), 0.0) == Approx(1));
+		CHECK(ranks[frozen.find_index("c")] > ranks[frozen.find_index("b")]);
+	}
+
+	SECTION("an empty graph") {
+		CHECK(gdwg::pagerank(gdwg::frozen_graph<int, int>{}).empty());
+	}
+
+	SECTION("arguments out of range") {
+		auto const g = gdwg::graph<int, int>{1, 2}.freeze();
+		CHECK_THROWS_MATCHES(gdwg::pagerank(g, 1.5),
+		                     std::runtime_error,
+		                     Catch::Matchers::Message("Cannot call gdwg::pagerank with a damping "
+		                                              "factor outside [0, 1]"));
+		CHECK_THROWS_MATCHES(gdwg::pagerank(g, 0.85, 0),
+		                     std::runtime_error,
+		                     Catch::Matchers::Message("Cannot call gdwg::pagerank with a tolerance "
+		                                              "that isn't positive"));
+	}
+}
+
+TEST_CASE("PageRank agrees with a plain power iteration") {
+	auto rng = std::mt19937(3);
+	auto const num_nodes = 2000;
+	auto node = std::uniform_int_distribution<int>(0, num_nodes - 1);
+	auto g = gdwg::graph<int, int, gdwg::layout::adjacency>{};
+	for (auto n = 0; n < num_nodes; ++n) {
+		g.insert_node(n);
+	}
+	for (auto n = 0; n < num_nodes; n += 2) {
+		auto const degree = 1 + num_nodes / (4 * (n + 1));
+		for (auto d = 0; d < degree; ++d) {
+			g.insert_edge(n, node(rng), 0);
+		}
+	}
+	auto const frozen = g.freeze();
+	auto const expected = expected_ranks(frozen, 0.85);
+	auto const threads = GENERATE(1U, 3U, 8U);
+	auto const ranks = gdwg::pagerank(frozen, 0.85, 1e-12, threads);
+	auto distance = 0.0;
+	for (auto i = std::size_t{0}; i < ranks.size(); ++i) {
+		distance += std::abs(ranks[i] - expected[i]);
+	}
+	CHECK(distance < 1e-9);
+}
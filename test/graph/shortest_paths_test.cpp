@@ -0,0 +1,134 @@
+#include "gdwg/graph.hpp"
+#include "gdwg/shortest_paths.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+TEMPLATE_TEST_CASE("Shortest paths",
+                   "",
+                   gdwg::layout::edge_tree,
+                   gdwg::layout::adjacency,
+                   gdwg::layout::interned<>) {
+	auto g = gdwg::graph<std::string, int, TestType>{"a", "b", "c", "d", "e"};
+	g.insert_edge("a", "b", 7);
+	g.insert_edge("a", "b", 2);
+	g.insert_edge("a", "c", 9);
+	g.insert_edge("b", "c", 3);
+	g.insert_edge("c", "d", 1);
+	g.insert_edge("d", "a", 1);
+	g.insert_edge("e", "a", 1);
+	auto const id = [&g](std::string const& value) { return *g.id_of(value); };
+
+	SECTION("distances and paths from a node") {
+		auto const paths = gdwg::shortest_paths(g, std::string("a"));
+		CHECK(paths.distance.size() == g.id_bound());
+		CHECK(paths.distance[static_cast<std::size_t>(id("a"))] == 0);
+		CHECK(paths.distance[static_cast<std::size_t>(id("b"))] == 2);
+		CHECK(paths.distance[static_cast<std::size_t>(id("c"))] == 5);
+		CHECK(paths.distance[static_cast<std::size_t>(id("d"))] == 6);
+		CHECK(paths.path_to(id("d")) == std::vector{id("a"), id("b"), id("c"), id("d")});
+		CHECK(paths.path_to(id("a")) == std::vector{id("a")});
+		CHECK(paths.predecessor[static_cast<std::size_t>(id("c"))] == id("b"));
+	}
+
+	SECTION("nodes the source can't reach") {
+		auto const paths = gdwg::shortest_paths(g, id("c"));
+		auto const e = id("e");
+		CHECK(not paths.reached(e));
+		CHECK(paths.distance[static_cast<std::size_t>(e)] == paths.unreachable);
+		CHECK(paths.path_to(e).empty());
+		CHECK(paths.distance[static_cast<std::size_t>(id("b"))] == 4);
+	}
+
+	SECTION("erased nodes leave unreachable ids") {
+		auto const b = id("b");
+		g.erase_node("b");
+		auto const paths = gdwg::shortest_paths(g, id("a"));
+		CHECK(paths.distance.size() == g.id_bound());
+		CHECK(not paths.reached(b));
+		CHECK(paths.distance[static_cast<std::size_t>(id("c"))] == 9);
+	}
+
+	SECTION("a source that isn't a node") {
+		CHECK_THROWS_MATCHES(gdwg::shortest_paths(g, std::string("z")),
+		                     std::runtime_error,
+		                     Catch::Matchers::Message("Cannot call gdwg::shortest_paths if source "
+		                                              "doesn't exist in the graph"));
+		auto const b = id("b");
+		g.erase_node("b");
+		CHECK_THROWS_AS(gdwg::shortest_paths(g, b), std::runtime_error);
+	}
+
+	SECTION("a negative weight") {
+		g.insert_edge("d", "e", -1);
+		CHECK_THROWS_MATCHES(gdwg::shortest_paths(g, std::string("a")),
+		                     std::runtime_error,
+		                     Catch::Matchers::Message("Cannot call gdwg::shortest_paths on a graph "
+		                                              "with a negative weight"));
+	}
+}
+
+TEST_CASE("Shortest paths too long for the weight type") {
+	SECTION("a longer path that would wrap round loses to a shorter one") {
+		auto g = gdwg::graph<int, unsigned char>{0, 1, 2, 3, 4};
+		g.insert_edge(0, 1, 200);
+		g.insert_edge(1, 3, 50);
+		g.insert_edge(0, 2, 20);
+		g.insert_edge(2, 3, 24);
+		g.insert_edge(1, 4, 100);
+		auto const paths = gdwg::shortest_paths(g, 0);
+		auto const at = [&g](int value) { return static_cast<std::size_t>(*g.id_of(value)); };
+		CHECK(paths.distance[at(3)] == 44);
+		CHECK(paths.path_to(*g.id_of(3)) == std::vector{*g.id_of(0), *g.id_of(2), *g.id_of(3)});
+		CHECK(not paths.reached(*g.id_of(4)));
+		CHECK(paths.distance[at(4)] == paths.unreachable);
+	}
+
+	SECTION("weights near the largest int") {
+		constexpr auto max = std::numeric_limits<int>::max();
+		auto g = gdwg::graph<int, int>{0, 1, 2};
+		g.insert_edge(0, 1, max - 1);
+		g.insert_edge(1, 2, 2);
+		auto const paths = gdwg::shortest_paths(g, 0);
+		CHECK(paths.distance[static_cast<std::size_t>(*g.id_of(1))] == max - 1);
+		CHECK(not paths.reached(*g.id_of(2)));
+	}
+}
+
+TEST_CASE("Shortest paths agree with Bellman-Ford") {
+	auto rng = std::mt19937(42);
+	auto node = std::uniform_int_distribution<int>(0, 199);
+	auto weight = std::uniform_real_distribution<double>(0, 10);
+	auto g = gdwg::graph<int, double, gdwg::layout::adjacency>{};
+	for (auto n = 0; n < 200; ++n) {
+		g.insert_node(n);
+	}
+	for (auto i = 0; i < 1000; ++i) {
+		g.insert_edge(node(rng), node(rng), weight(rng));
+	}
+
+	auto const paths = gdwg::shortest_paths(g, 0);
+	auto expected = std::vector<double>(g.id_bound(), paths.unreachable);
+	expected[static_cast<std::size_t>(*g.id_of(0))] = 0;
+	for (auto round = std::size_t{0}; round < g.id_bound(); ++round) {
+		for (auto const& [from, to, w] : g) {
+			auto const src = static_cast<std::size_t>(*g.id_of(from));
+			auto const dst = static_cast<std::size_t>(*g.id_of(to));
+			expected[dst] = std::min(expected[dst], expected[src] + w);
+		}
+	}
+	for (auto i = std::size_t{0}; i < expected.size(); ++i) {
+		if (expected[i] == paths.unreachable) {
+			CHECK(paths.distance[i] == paths.unreachable);
+		}
+		else {
+			CHECK(paths.distance[i] == Approx(expected[i]));
+		}
+	}
+}
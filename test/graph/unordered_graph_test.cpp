@@ -0,0 +1,212 @@
+#include "gdwg/graph.hpp"
+#include "gdwg/unordered_graph.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace {
+	template<typename G>
+	auto sorted_edges(G const& g) -> std::vector<std::tuple<int, int, int>> {
+		auto v = std::vector<std::tuple<int, int, int>>{};
+		for (auto const& [from, to, weight] : g) {
+			v.emplace_back(from, to, weight);
+		}
+		std::sort(v.begin(), v.end());
+		return v;
+	}
+
+	template<typename T>
+	auto sorted(std::vector<T> v) -> std::vector<T> {
+		std::sort(v.begin(), v.end());
+		return v;
+	}
+} // namespace
+
+TEST_CASE("Unordered graph") {
+	auto g = gdwg::unordered_graph<std::string, int>{"c", "a", "b"};
+	g.insert_edge("a", "b", 3);
+	g.insert_edge("a", "b", 1);
+	g.insert_edge("a", "a", 2);
+	g.insert_edge("c", "a", 5);
+
+	SECTION("nodes and edges come in slot order, weights ascending") {
+		CHECK(g.nodes() == std::vector<std::string>{"c", "a", "b"});
+		CHECK(g.connections("a") == std::vector<std::string>{"a", "b", "b"});
+		CHECK(g.incoming("a") == std::vector<std::string>{"c", "a"});
+		CHECK(g.weights("a", "b") == std::vector<int>{1, 3});
+		auto out = std::ostringstream{};
+		out << g;
+		CHECK(out.str() == "c (\n  a | 5\n)\na (\n  a | 2\n  b | 1\n  b | 3\n)\nb (\n)\n");
+	}
+
+	SECTION("an erased node's slot is reused") {
+		CHECK(g.erase_node("c"));
+		CHECK(!g.erase_node("c"));
+		CHECK(g.insert_node("d"));
+		CHECK(g.nodes() == std::vector<std::string>{"d", "a", "b"});
+		CHECK(g.incoming("a") == std::vector<std::string>{"a"});
+	}
+
+	SECTION("replace_node keeps the edges in place") {
+		CHECK(g.replace_node("a", "z"));
+		CHECK(!g.replace_node("z", "b"));
+		CHECK(g.nodes() == std::vector<std::string>{"c", "z", "b"});
+		CHECK(g.weights("z", "b") == std::vector<int>{1, 3});
+		CHECK(g.is_connected("z", "z"));
+		CHECK(g.is_connected("c", "z"));
+		CHECK(!g.is_node("a"));
+	}
+
+	SECTION("merge_replace_node drops duplicates") {
+		g.insert_edge("c", "b", 1);
+		g.merge_replace_node("c", "a");
+		CHECK(g.nodes() == std::vector<std::string>{"a", "b"});
+		CHECK(sorted(g.weights("a", "a")) == std::vector<int>{2, 5});
+		CHECK(g.weights("a", "b") == std::vector<int>{1, 3});
+		CHECK(std::distance(g.begin(), g.end()) == 4);
+	}
+
+	SECTION("iterators") {
+		auto const it = g.find("a", "b", 3);
+		REQUIRE(it != g.end());
+		CHECK((*it).weight == 3);
+		CHECK(g.find("a", "b", 4) == g.end());
+		CHECK((*std::prev(g.end())).weight == 3);
+		auto const next = g.erase_edge(g.find("a", "a", 2));
+		CHECK((*next).to == "b");
+		CHECK(g.erase_edge(g.begin(), g.end()) == g.end());
+		CHECK(g.begin() == g.end());
+		CHECK(g.nodes().size() == 3);
+	}
+
+	SECTION("equality doesn't depend on order") {
+		auto h = gdwg::unordered_graph<std::string, int>{"b", "a", "c"};
+		h.insert_edge("c", "a", 5);
+		h.insert_edge("a", "a", 2);
+		h.insert_edge("a", "b", 1);
+		CHECK(!(g == h));
+		h.insert_edge("a", "b", 3);
+		CHECK(g == h);
+		h.erase_edge("a", "b", 3);
+		h.insert_edge("a", "b", 4);
+		CHECK(!(g == h));
+	}
+
+	SECTION("erase_edges erases a batch") {
+		auto const batch = std::vector<gdwg::unordered_graph<std::string, int>::value_type>{
+		   {"a", "b", 1},
+		   {"a", "b", 7},
+		   {"c", "a", 5}};
+		CHECK(g.erase_edges(batch.begin(), batch.end()) == 2);
+		CHECK(g.weights("a", "b") == std::vector<int>{3});
+		CHECK(not g.is_connected("c", "a"));
+		auto const bad = std::vector<gdwg::unordered_graph<std::string, int>::value_type>{
+		   {"a", "b", 3},
+		   {"a", "z", 1}};
+		CHECK_THROWS_WITH(g.erase_edges(bad.begin(), bad.end()),
+		                  "Cannot call gdwg::unordered_graph<N, E>::erase_edges on src or dst if "
+		                  "they don't exist in the graph");
+		CHECK(g.weights("a", "b") == std::vector<int>{3});
+	}
+
+	SECTION("the fingerprint follows the contents, not the order") {
+		auto h = gdwg::unordered_graph<std::string, int>{"b", "a", "c"};
+		h.insert_edge("c", "a", 5);
+		h.insert_edge("a", "a", 2);
+		h.insert_edge("a", "b", 1);
+		CHECK(h.fingerprint() != g.fingerprint());
+		h.insert_edge("a", "b", 3);
+		CHECK(h.fingerprint() == g.fingerprint());
+		h.replace_node("a", "z");
+		CHECK(h.fingerprint() != g.fingerprint());
+		h.replace_node("z", "a");
+		CHECK(h.fingerprint() == g.fingerprint());
+		h.clear();
+		CHECK(h.fingerprint() == gdwg::unordered_graph<std::string, int>{}.fingerprint());
+	}
+
+	SECTION("errors") {
+		CHECK_THROWS_WITH(g.insert_edge("a", "z", 1),
+		                  "Cannot call gdwg::unordered_graph<N, E>::insert_edge when either src or "
+		                  "dst node does not exist");
+		CHECK_THROWS_WITH(g.replace_node("z", "y"),
+		                  "Cannot call gdwg::unordered_graph<N, E>::replace_node on a node that "
+		                  "doesn't exist");
+		CHECK_THROWS(g.merge_replace_node("z", "a"));
+		CHECK_THROWS(g.erase_edge("a", "z", 1));
+		CHECK_THROWS(g.is_connected("z", "a"));
+		CHECK_THROWS(g.weights("z", "a"));
+		CHECK_THROWS(g.connections("z"));
+		CHECK_THROWS(g.incoming("z"));
+	}
+}
+
+TEST_CASE("Unordered graph agrees with graph") {
+	auto rng = std::mt19937(42);
+	auto pick = [&rng](int n) { return std::uniform_int_distribution<int>(0, n - 1)(rng); };
+	auto ordered = gdwg::graph<int, int>{};
+	auto unordered = gdwg::unordered_graph<int, int>{};
+	for (auto step = 0; step < 20000; ++step) {
+		auto const a = pick(64);
+		auto const b = pick(64);
+		auto const w = pick(4);
+		switch (pick(10)) {
+		case 0:
+		case 1: CHECK(unordered.insert_node(a) == ordered.insert_node(a)); break;
+		case 2: CHECK(unordered.erase_node(a) == ordered.erase_node(a)); break;
+		case 3:
+			if (ordered.is_node(a)) {
+				CHECK(unordered.replace_node(a, b) == ordered.replace_node(a, b));
+			}
+			break;
+		case 4:
+			if (ordered.is_node(a) and ordered.is_node(b) and a != b) {
+				ordered.merge_replace_node(a, b);
+				unordered.merge_replace_node(a, b);
+			}
+			break;
+		case 5:
+			if (ordered.is_node(a) and ordered.is_node(b)) {
+				CHECK(unordered.erase_edge(a, b, w) == ordered.erase_edge(a, b, w));
+			}
+			break;
+		case 6:
+			if (ordered.is_node(a) and ordered.is_node(b)) {
+				auto const batch = std::vector<gdwg::graph<int, int>::value_type>{{a, b, w}, {b, a, w}};
+				auto const same = std::vector<gdwg::unordered_graph<int, int>::value_type>{
+				   {a, b, w},
+				   {b, a, w}};
+				CHECK(unordered.erase_edges(same.begin(), same.end())
+				      == ordered.erase_edges(batch.begin(), batch.end()));
+			}
+			break;
+		default:
+			if (ordered.is_node(a) and ordered.is_node(b)) {
+				CHECK(unordered.insert_edge(a, b, w) == ordered.insert_edge(a, b, w));
+			}
+			break;
+		}
+		if (ordered.is_node(a)) {
+			REQUIRE(sorted(unordered.connections(a)) == ordered.connections(a));
+			REQUIRE(sorted(unordered.incoming(a)) == ordered.incoming(a));
+		}
+		REQUIRE(unordered.fingerprint() == ordered.fingerprint());
+	}
+	CHECK(sorted(unordered.nodes()) == ordered.nodes());
+	CHECK(sorted_edges(unordered) == sorted_edges(ordered));
+
+	auto nodes = ordered.nodes();
+	auto rebuilt = gdwg::unordered_graph<int, int>(nodes.rbegin(), nodes.rend());
+	for (auto const& [from, to, weight] : ordered) {
+		rebuilt.insert_edge(from, to, weight);
+	}
+	CHECK(rebuilt == unordered);
+	CHECK(rebuilt.fingerprint() == unordered.fingerprint());
+}